@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include "async_deque.hpp"
+
+using Clock = std::chrono::high_resolution_clock;
+
+struct Task {
+    struct promise_type {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+std::deque<std::coroutine_handle<>> ready_queue;
+
+void RunReady() {
+    while (!ready_queue.empty()) {
+        auto handle = ready_queue.front();
+        ready_queue.pop_front();
+        handle.resume();
+    }
+}
+
+Task Produce(AsyncDeque<Clock::time_point>& queue, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        co_await queue.push_back(Clock::now());
+    }
+}
+
+Task Consume(AsyncDeque<Clock::time_point>& queue, size_t count,
+             std::vector<double>& latencies) {
+    for (size_t i = 0; i < count; ++i) {
+        Clock::time_point pushed = co_await queue.pop_front();
+        latencies.push_back(std::chrono::duration<double, std::nano>(Clock::now() - pushed).count());
+    }
+}
+
+static constexpr size_t kTestSize = 1000000;
+
+int main() {
+    for (size_t capacity: {size_t(0), size_t(1), size_t(64)}) {
+        AsyncDeque<Clock::time_point> queue(
+            capacity, [](std::coroutine_handle<> handle) { ready_queue.push_back(handle); });
+        std::vector<double> latencies;
+        latencies.reserve(kTestSize);
+
+        auto start = Clock::now();
+        Consume(queue, kTestSize, latencies);
+        Produce(queue, kTestSize);
+        RunReady();
+        auto stop = Clock::now();
+
+        std::sort(latencies.begin(), latencies.end());
+        double seconds = std::chrono::duration<double>(stop - start).count();
+        std::cout << "capacity " << capacity << ": " << kTestSize / seconds / 1e6
+                  << " M items/s, latency p50 " << latencies[kTestSize / 2] << " ns, p99 "
+                  << latencies[kTestSize * 99 / 100] << " ns" << std::endl;
+    }
+
+    AsyncDeque<Clock::time_point> queue;
+    auto start = Clock::now();
+    for (size_t i = 0; i < kTestSize; ++i) {
+        queue.try_push_back(Clock::now());
+        queue.try_pop_front();
+    }
+    auto stop = Clock::now();
+    std::cout << "try_push_back/try_pop_front: "
+              << kTestSize / std::chrono::duration<double>(stop - start).count() / 1e6
+              << " M items/s" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <coroutine>
+#include <functional>
+#include <optional>
+#include <utility>
+
+#include "deque.hpp"
+
+template <typename T, typename Allocator = std::allocator<T>>
+class AsyncDeque {
+ public:
+  using Executor = std::function<void(std::coroutine_handle<>)>;
+
+  class PopAwaiter;
+  class PushAwaiter;
+
+  AsyncDeque(size_t capacity = 0, Executor executor = Executor(),
+             const Allocator& alloc = Allocator());
+
+  AsyncDeque(const AsyncDeque& other) = delete;
+
+  AsyncDeque& operator=(const AsyncDeque& other) = delete;
+
+  [[nodiscard]] size_t size() const { return deque_.size(); }
+
+  [[nodiscard]] bool empty() const { return deque_.empty(); }
+
+  [[nodiscard]] size_t capacity() const { return capacity_; }
+
+  [[nodiscard]] PopAwaiter pop_front() { return PopAwaiter(this); }
+
+  [[nodiscard]] PushAwaiter push_back(T value) {
+    return PushAwaiter(this, std::move(value));
+  }
+
+  bool try_push_back(T&& value);
+
+  std::optional<T> try_pop_front();
+
+ private:
+  [[nodiscard]] bool full() const {
+    return capacity_ != 0 && deque_.size() >= capacity_;
+  }
+
+  void schedule(std::coroutine_handle<> handle) {
+    if (executor_) {
+      executor_(handle);
+    } else {
+      handle.resume();
+    }
+  }
+
+  T take_front();
+
+  size_t capacity_ = 0;
+  Executor executor_;
+  Deque<T, Allocator> deque_;
+  PopAwaiter* pop_head_ = nullptr;
+  PopAwaiter* pop_tail_ = nullptr;
+  PushAwaiter* push_head_ = nullptr;
+  PushAwaiter* push_tail_ = nullptr;
+};
+
+template <typename T, typename Allocator>
+class AsyncDeque<T, Allocator>::PopAwaiter {
+ public:
+  explicit PopAwaiter(AsyncDeque* queue) : queue_(queue) {}
+
+  bool await_ready() {
+    if (queue_->deque_.empty()) {
+      return false;
+    }
+    value_.emplace(queue_->take_front());
+    return true;
+  }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    if (queue_->pop_tail_ == nullptr) {
+      queue_->pop_head_ = this;
+    } else {
+      queue_->pop_tail_->next_ = this;
+    }
+    queue_->pop_tail_ = this;
+  }
+
+  T await_resume() { return std::move(*value_); }
+
+ private:
+  friend class AsyncDeque;
+
+  AsyncDeque* queue_;
+  PopAwaiter* next_ = nullptr;
+  std::coroutine_handle<> handle_;
+  std::optional<T> value_;
+};
+
+template <typename T, typename Allocator>
+class AsyncDeque<T, Allocator>::PushAwaiter {
+ public:
+  PushAwaiter(AsyncDeque* queue, T&& value)
+      : queue_(queue), value_(std::move(value)) {}
+
+  bool await_ready() { return queue_->try_push_back(std::move(value_)); }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    if (queue_->push_tail_ == nullptr) {
+      queue_->push_head_ = this;
+    } else {
+      queue_->push_tail_->next_ = this;
+    }
+    queue_->push_tail_ = this;
+  }
+
+  void await_resume() {}
+
+ private:
+  friend class AsyncDeque;
+
+  AsyncDeque* queue_;
+  PushAwaiter* next_ = nullptr;
+  std::coroutine_handle<> handle_;
+  T value_;
+};
+
+template <typename T, typename Allocator>
+AsyncDeque<T, Allocator>::AsyncDeque(size_t capacity, Executor executor,
+                                     const Allocator& alloc)
+    : capacity_(capacity), executor_(std::move(executor)), deque_(alloc) {}
+
+template <typename T, typename Allocator>
+bool AsyncDeque<T, Allocator>::try_push_back(T&& value) {
+  if (pop_head_ != nullptr) {
+    PopAwaiter* waiter = pop_head_;
+    pop_head_ = waiter->next_;
+    if (pop_head_ == nullptr) {
+      pop_tail_ = nullptr;
+    }
+    waiter->value_.emplace(std::move(value));
+    schedule(waiter->handle_);
+    return true;
+  }
+  if (full()) {
+    return false;
+  }
+  deque_.push_back(std::move(value));
+  return true;
+}
+
+template <typename T, typename Allocator>
+std::optional<T> AsyncDeque<T, Allocator>::try_pop_front() {
+  if (deque_.empty()) {
+    return std::nullopt;
+  }
+  return take_front();
+}
+
+template <typename T, typename Allocator>
+T AsyncDeque<T, Allocator>::take_front() {
+  T value = std::move(deque_[0]);
+  deque_.pop_front();
+  if (push_head_ != nullptr && !full()) {
+    PushAwaiter* waiter = push_head_;
+    push_head_ = waiter->next_;
+    if (push_head_ == nullptr) {
+      push_tail_ = nullptr;
+    }
+    deque_.push_back(std::move(waiter->value_));
+    schedule(waiter->handle_);
+  }
+  return value;
+}
@@ -0,0 +1,117 @@
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include "deque.hpp"
+#include "compressed_deque.hpp"
+
+static size_t live_bytes = 0;
+static constexpr size_t kHeader = 16;
+
+void* operator new(size_t size) {
+    auto* block = static_cast<char*>(std::malloc(size + kHeader));
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<size_t*>(block) = size;
+    live_bytes += size;
+    return block + kHeader;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    char* block = static_cast<char*>(ptr) - kHeader;
+    live_bytes -= *reinterpret_cast<size_t*>(block);
+    std::free(block);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+template <typename F>
+double MeasureMs(F&& func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+static constexpr size_t kTestSize = 10000000;
+static constexpr size_t kLookups = 2000000;
+
+int main() {
+    std::mt19937 mersenne_engine{42};
+    std::vector<int64_t> timestamps(kTestSize);
+    int64_t now = 1700000000000;
+    for (auto& timestamp: timestamps) {
+        now += mersenne_engine() % 1000;
+        timestamp = now;
+    }
+    std::vector<size_t> lookups(kLookups);
+    for (auto& lookup: lookups) {
+        lookup = mersenne_engine() % kTestSize;
+    }
+
+    Deque<int64_t> plain;
+    CompressedDeque<int64_t> compressed;
+    size_t before = live_bytes;
+    double plain_push = MeasureMs([&]() {
+        for (const auto& timestamp: timestamps) {
+            plain.push_back(timestamp);
+        }
+    });
+    size_t plain_bytes = live_bytes - before;
+    before = live_bytes;
+    double compressed_push = MeasureMs([&]() {
+        for (const auto& timestamp: timestamps) {
+            compressed.push_back(timestamp);
+        }
+    });
+    size_t compressed_bytes = live_bytes - before;
+
+    int64_t sink = 0;
+    double plain_scan = MeasureMs([&]() {
+        std::as_const(plain).for_each_segment([&sink](const int64_t* ptr, size_t len) {
+            for (size_t i = 0; i < len; ++i) {
+                sink += ptr[i];
+            }
+        });
+    });
+    double compressed_scan = MeasureMs([&]() {
+        compressed.for_each([&sink](int64_t value) { sink += value; });
+    });
+    double plain_lookup = MeasureMs([&]() {
+        for (const auto& lookup: lookups) {
+            sink += std::as_const(plain)[static_cast<int>(lookup)];
+        }
+    });
+    double compressed_lookup = MeasureMs([&]() {
+        for (const auto& lookup: lookups) {
+            sink += compressed[lookup];
+        }
+    });
+
+    std::cout << "memory: Deque " << plain_bytes / (1 << 20) << " MiB allocated ("
+              << static_cast<double>(plain_bytes) / kTestSize << " B/element), CompressedDeque "
+              << compressed_bytes / (1 << 20) << " MiB allocated ("
+              << static_cast<double>(compressed_bytes) / kTestSize << " B/element, "
+              << compressed.memory_bytes() << " bytes by memory_bytes(), " << compressed_bytes << " counted), ratio "
+              << static_cast<double>(plain_bytes) / static_cast<double>(compressed_bytes) << "x"
+              << std::endl;
+    std::cout << "push_back: Deque " << plain_push << " ms, CompressedDeque "
+              << compressed_push << " ms" << std::endl;
+    std::cout << "scan: Deque " << plain_scan << " ms, CompressedDeque " << compressed_scan
+              << " ms" << std::endl;
+    std::cout << "random lookups: Deque " << plain_lookup << " ms, CompressedDeque "
+              << compressed_lookup << " ms" << std::endl;
+    std::cout << "(checksum " << sink << ")" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#include "deque.hpp"
+
+template <typename T>
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+class CompressedDeque {
+ public:
+  static const size_t kBlockSize = 128;
+
+  [[nodiscard]] size_t size() const {
+    return head_.size() + sealed_.size() * kBlockSize + tail_.size();
+  }
+
+  [[nodiscard]] bool empty() const { return size() == 0; }
+
+  T operator[](size_t ind) const;
+
+  T at(size_t ind) const;
+
+  void push_back(T value);
+
+  void push_front(T value);
+
+  void pop_back();
+
+  void pop_front();
+
+  template <typename F>
+  void for_each(F&& func) const;
+
+  [[nodiscard]] size_t memory_bytes() const;
+
+ private:
+  using Key = std::make_unsigned_t<T>;
+
+  struct PackedBlock {
+    PackedBlock(const T* values);
+
+    T get(size_t ind) const;
+
+    void decode(T* out) const;
+
+    [[nodiscard]] size_t word_cnt() const {
+      return (kBlockSize * width + 63) / 64;
+    }
+
+    T base;
+    unsigned width;
+    std::unique_ptr<uint64_t[]> words;
+  };
+
+  template <typename U>
+  static size_t deque_bytes(const Deque<U>& deque) {
+    size_t slots =
+        deque.capacity_front() + deque.size() + deque.capacity_back();
+    return slots * sizeof(U) + slots / Deque<U>::kBucketSize * sizeof(U*);
+  }
+
+  void seal_head();
+
+  void seal_tail();
+
+  void unseal_head();
+
+  void unseal_tail();
+
+  Deque<T> head_;
+  Deque<PackedBlock> sealed_;
+  Deque<T> tail_;
+  size_t packed_words_ = 0;
+};
+
+template <typename T>
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+CompressedDeque<T>::PackedBlock::PackedBlock(const T* values)
+    : base(values[0]) {
+  for (size_t i = 1; i < kBlockSize; ++i) {
+    base = std::min(base, values[i]);
+  }
+  Key range = 0;
+  for (size_t i = 0; i < kBlockSize; ++i) {
+    range |= static_cast<Key>(static_cast<Key>(values[i]) -
+                              static_cast<Key>(base));
+  }
+  width = std::bit_width(range);
+  words = std::make_unique<uint64_t[]>(word_cnt());
+  if (width == 0) {
+    return;
+  }
+  for (size_t i = 0; i < kBlockSize; ++i) {
+    uint64_t delta = static_cast<Key>(static_cast<Key>(values[i]) -
+                                       static_cast<Key>(base));
+    size_t bit = i * width;
+    size_t word = bit / 64;
+    size_t offset = bit % 64;
+    words[word] |= delta << offset;
+    if (offset + width > 64) {
+      words[word + 1] |= delta >> (64 - offset);
+    }
+  }
+}
+
+template <typename T>
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+T CompressedDeque<T>::PackedBlock::get(size_t ind) const {
+  if (width == 0) {
+    return base;
+  }
+  size_t bit = ind * width;
+  size_t word = bit / 64;
+  size_t offset = bit % 64;
+  uint64_t delta = words[word] >> offset;
+  if (offset + width > 64) {
+    delta |= words[word + 1] << (64 - offset);
+  }
+  uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+  return static_cast<T>(static_cast<Key>(base) +
+                        static_cast<Key>(delta & mask));
+}
+
+template <typename T>
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+void CompressedDeque<T>::PackedBlock::decode(T* out) const {
+  if (width == 0) {
+    std::fill(out, out + kBlockSize, base);
+    return;
+  }
+  const uint64_t* src = words.get();
+  uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+  for (size_t i = 0; i < kBlockSize; ++i) {
+    size_t bit = i * width;
+    size_t offset = bit % 64;
+    uint64_t lo = src[bit / 64] >> offset;
+    uint64_t hi = offset + width > 64 ? src[bit / 64 + 1] << (64 - offset) : 0;
+    out[i] = static_cast<T>(static_cast<Key>(base) +
+                            static_cast<Key>((lo | hi) & mask));
+  }
+}
+
+template <typename T>
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+T CompressedDeque<T>::operator[](size_t ind) const {
+  if (ind < head_.size()) {
+    return head_[static_cast<int>(ind)];
+  }
+  ind -= head_.size();
+  if (ind < sealed_.size() * kBlockSize) {
+    return sealed_[static_cast<int>(ind / kBlockSize)].get(ind % kBlockSize);
+  }
+  return tail_[static_cast<int>(ind - sealed_.size() * kBlockSize)];
+}
+
+template <typename T>
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+T CompressedDeque<T>::at(size_t ind) const {
+  if (ind >= size()) {
+    throw std::out_of_range("Index out of range!");
+  }
+  return operator[](ind);
+}
+
+template <typename T>
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+void CompressedDeque<T>::push_back(T value) {
+  tail_.push_back(value);
+  if (tail_.size() == 2 * kBlockSize) {
+    seal_tail();
+  }
+}
+
+template <typename T>
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+void CompressedDeque<T>::push_front(T value) {
+  head_.push_front(value);
+  if (head_.size() == 2 * kBlockSize) {
+    seal_head();
+  }
+}
+
+template <typename T>
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+void CompressedDeque<T>::pop_back() {
+  if (tail_.empty()) {
+    if (sealed_.empty()) {
+      head_.pop_back();
+      return;
+    }
+    unseal_tail();
+  }
+  tail_.pop_back();
+}
+
+template <typename T>
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+void CompressedDeque<T>::pop_front() {
+  if (head_.empty()) {
+    if (sealed_.empty()) {
+      tail_.pop_front();
+      return;
+    }
+    unseal_head();
+  }
+  head_.pop_front();
+}
+
+template <typename T>
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+void CompressedDeque<T>::seal_head() {
+  T values[kBlockSize];
+  int offset = static_cast<int>(head_.size() - kBlockSize);
+  for (size_t i = 0; i < kBlockSize; ++i) {
+    values[i] = head_[offset + static_cast<int>(i)];
+  }
+  sealed_.push_front(PackedBlock(values));
+  packed_words_ += sealed_[0].word_cnt();
+  for (size_t i = 0; i < kBlockSize; ++i) {
+    head_.pop_back();
+  }
+}
+
+template <typename T>
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+void CompressedDeque<T>::seal_tail() {
+  T values[kBlockSize];
+  for (size_t i = 0; i < kBlockSize; ++i) {
+    values[i] = tail_[static_cast<int>(i)];
+  }
+  sealed_.push_back(PackedBlock(values));
+  packed_words_ += sealed_[static_cast<int>(sealed_.size()) - 1].word_cnt();
+  for (size_t i = 0; i < kBlockSize; ++i) {
+    tail_.pop_front();
+  }
+}
+
+template <typename T>
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+void CompressedDeque<T>::unseal_head() {
+  T values[kBlockSize];
+  sealed_[0].decode(values);
+  for (size_t i = 0; i < kBlockSize; ++i) {
+    head_.push_back(values[i]);
+  }
+  packed_words_ -= sealed_[0].word_cnt();
+  sealed_.pop_front();
+}
+
+template <typename T>
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+void CompressedDeque<T>::unseal_tail() {
+  T values[kBlockSize];
+  int last = static_cast<int>(sealed_.size()) - 1;
+  sealed_[last].decode(values);
+  for (size_t i = kBlockSize; i > 0; --i) {
+    tail_.push_front(values[i - 1]);
+  }
+  packed_words_ -= sealed_[last].word_cnt();
+  sealed_.pop_back();
+}
+
+template <typename T>
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+template <typename F>
+void CompressedDeque<T>::for_each(F&& func) const {
+  auto visit = [&func](const T* ptr, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+      func(ptr[i]);
+    }
+  };
+  head_.for_each_segment(visit);
+  T values[kBlockSize];
+  sealed_.for_each_segment([&](const PackedBlock* blocks, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+      blocks[i].decode(values);
+      visit(values, kBlockSize);
+    }
+  });
+  tail_.for_each_segment(visit);
+}
+
+template <typename T>
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+size_t CompressedDeque<T>::memory_bytes() const {
+  return deque_bytes(head_) + deque_bytes(sealed_) + deque_bytes(tail_) +
+         packed_words_ * sizeof(uint64_t);
+}
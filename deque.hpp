@@ -1,22 +1,41 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 template <typename T, typename Allocator = std::allocator<T>>
 class Deque {
  public:
+  struct Parallel {
+    size_t threads;
+  };
+
   Deque() = default;
 
   Deque(const Allocator& alloc);
 
   Deque(const Deque& other);
 
+  Deque(const Deque& other, Parallel par);
+
   Deque(size_t count, const Allocator& alloc = Allocator());
 
   Deque(size_t count, const T& value, const Allocator& alloc = Allocator());
 
+  Deque(size_t count, const T& value, Parallel par,
+        const Allocator& alloc = Allocator());
+
   Deque(Deque&& other) noexcept;
 
   Deque(std::initializer_list<T> init, const Allocator& alloc = Allocator());
@@ -27,6 +46,10 @@ class Deque {
 
   Deque& operator=(Deque&& other) noexcept;
 
+  Deque& assign(const Deque& other, Parallel par);
+
+  void clear(Parallel par = Parallel{1});
+
   [[nodiscard]] size_t size() const;
 
   [[nodiscard]] bool empty() const;
@@ -57,6 +80,30 @@ class Deque {
 
   void pop_front();
 
+  void pop_back_n(size_t count);
+
+  void pop_front_n(size_t count);
+
+  template <typename OutputIt>
+  OutputIt drain_back_into(OutputIt out, size_t count);
+
+  template <typename OutputIt>
+  OutputIt drain_front_into(OutputIt out, size_t count);
+
+  std::span<T> linearize();
+
+  std::optional<std::span<T>> try_contiguous();
+
+  std::optional<std::span<const T>> try_contiguous() const;
+
+  void reserve_back(size_t count);
+
+  void reserve_front(size_t count);
+
+  [[nodiscard]] size_t capacity_back() const;
+
+  [[nodiscard]] size_t capacity_front() const;
+
   [[nodiscard]] bool is_index_inside(size_t bucket_num, size_t elem_num) const;
 
   template <bool IsConst = false>
@@ -68,24 +115,18 @@ class Deque {
   using const_reverse_iterator = std::reverse_iterator<BaseIterator<true>>;
 
   iterator begin() {
-    return iterator(data_, static_cast<int>(first_bucket_),
-                    static_cast<int>(first_pos_), size_);
+    return owned(iterator(data_, static_cast<int>(first_bucket_),
+                          static_cast<int>(first_pos_), size_));
   }
 
-  const_iterator begin() const {
-    return const_iterator(data_, static_cast<int>(first_bucket_),
-                          static_cast<int>(first_pos_), size_);
-  }
+  const_iterator begin() const { return cbegin(); }
 
   iterator end() {
-    return iterator(data_, static_cast<int>(last_bucket_),
-                    static_cast<int>(last_pos_) + 1, size_);
+    return owned(iterator(data_, static_cast<int>(last_bucket_),
+                          static_cast<int>(last_pos_) + 1, size_));
   }
 
-  const_iterator end() const {
-    return const_iterator(data_, static_cast<int>(last_bucket_),
-                          static_cast<int>(last_pos_) + 1, size_);
-  }
+  const_iterator end() const { return cend(); }
 
   const_iterator cbegin() const {
     return const_iterator(const_cast<const T**>(data_),
@@ -99,14 +140,12 @@ class Deque {
                           static_cast<int>(last_pos_) + 1, size_);
   }
 
-  reverse_iterator rbegin() {
-    return reverse_iterator({data_, static_cast<int>(last_bucket_),
-                             static_cast<int>(last_pos_) + 1, size_});
-  }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
 
   reverse_iterator rend() {
-    return reverse_iterator({data_, static_cast<int>(first_bucket_),
-                             static_cast<int>(first_pos_) - 1, size_});
+    return reverse_iterator(
+        owned(iterator(data_, static_cast<int>(first_bucket_),
+                       static_cast<int>(first_pos_) - 1, size_)));
   }
 
   const_reverse_iterator crbegin() const {
@@ -128,6 +167,64 @@ class Deque {
   template <bool IsConst>
   void erase(BaseIterator<IsConst> iter);
 
+  template <typename Compare = std::less<T>>
+  void sort(Compare comp = Compare(), Parallel par = Parallel{1});
+
+  template <typename Compare = std::less<T>>
+  void stable_sort(Compare comp = Compare(), Parallel par = Parallel{1});
+
+  void radix_sort()
+    requires(std::is_integral_v<T> && !std::is_same_v<T, bool>);
+
+  template <typename F>
+  void for_each_segment(F&& func);
+
+  template <typename F>
+  void for_each_segment(F&& func) const;
+
+  class Snapshot;
+
+  Snapshot snapshot()
+    requires std::is_copy_constructible_v<T>;
+
+  struct Handle {
+    Deque* deque;
+    long long seq;
+    long long front_epoch;
+    long long back_epoch;
+
+    T& operator*() const { return (*deque)[index()]; }
+
+    T* operator->() const { return &(*deque)[index()]; }
+
+   private:
+    int index() const { return static_cast<int>(seq - deque->front_seq_); }
+  };
+
+  Handle get_handle(size_t ind) {
+    return {this, front_seq_ + static_cast<long long>(ind), front_epoch_,
+            back_epoch_};
+  }
+
+  [[nodiscard]] bool is_alive(const Handle& handle) const {
+    if (handle.deque != this || handle.seq < front_seq_ ||
+        handle.seq >= back_seq()) {
+      return false;
+    }
+    const Reuse* back = first_reuse_after(back_reuses_, handle.back_epoch);
+    const Reuse* front = first_reuse_after(front_reuses_, handle.front_epoch);
+    return (back == nullptr || handle.seq < back->seq) &&
+           (front == nullptr || handle.seq > front->seq);
+  }
+
+  [[nodiscard]] size_t index_of(const Handle& handle) const {
+    return static_cast<size_t>(handle.seq - front_seq_);
+  }
+
+  iterator iterator_of(const Handle& handle) {
+    return begin() + static_cast<int>(index_of(handle));
+  }
+
   [[nodiscard]] Allocator get_allocator() const { return alloc_; }
 
   static const size_t kBucketSize = 5;
@@ -141,12 +238,148 @@ class Deque {
 
   T** reserve(size_t new_cap, alloc& cur_alloc, bucket_alloc& cur_bucket_alloc);
 
+  void grow_map(size_t front_buckets, size_t back_buckets);
+
+  void recycle_front();
+
+  void recycle_back();
+
   void my_swap(size_t& lhs, size_t& rhs) {
     std::swap(lhs, rhs);
     rhs = 0;
   }
 
-  void clear();
+  long long back_seq() const {
+    return front_seq_ + static_cast<long long>(size_);
+  }
+
+  struct Reuse {
+    long long epoch;
+    long long seq;
+  };
+
+  static const Reuse* first_reuse_after(const std::vector<Reuse>& reuses,
+                                        long long epoch) {
+    auto iter = std::partition_point(
+        reuses.begin(), reuses.end(),
+        [epoch](const Reuse& reuse) { return reuse.epoch <= epoch; });
+    return iter == reuses.end() ? nullptr : &*iter;
+  }
+
+  void reuse_front(long long seq) {
+    ++front_epoch_;
+    while (!front_reuses_.empty() && front_reuses_.back().seq <= seq) {
+      front_reuses_.pop_back();
+    }
+    front_reuses_.push_back({front_epoch_, seq});
+    auto covered = std::partition_point(
+        front_reuses_.begin(), front_reuses_.end(),
+        [this](const Reuse& reuse) { return reuse.seq >= back_seq() - 1; });
+    if (covered - front_reuses_.begin() > 1) {
+      front_reuses_.erase(front_reuses_.begin(), covered - 1);
+    }
+  }
+
+  void reuse_back(long long seq) {
+    ++back_epoch_;
+    while (!back_reuses_.empty() && back_reuses_.back().seq >= seq) {
+      back_reuses_.pop_back();
+    }
+    back_reuses_.push_back({back_epoch_, seq});
+    auto covered = std::partition_point(
+        back_reuses_.begin(), back_reuses_.end(),
+        [this](const Reuse& reuse) { return reuse.seq <= front_seq_; });
+    if (covered - back_reuses_.begin() > 1) {
+      back_reuses_.erase(back_reuses_.begin(), covered - 1);
+    }
+  }
+
+  void invalidate_handles() {
+    reuse_back(std::numeric_limits<long long>::min());
+  }
+
+  std::pair<size_t, size_t> live_range(size_t bucket_num) const {
+    if (size_ == 0 || bucket_num < first_bucket_ || bucket_num > last_bucket_) {
+      return {0, 0};
+    }
+    return {bucket_num == first_bucket_ ? first_pos_ : 0,
+            bucket_num == last_bucket_ ? last_pos_ + 1 : kBucketSize};
+  }
+
+  template <typename Fill, typename Destroy>
+  T** build_buckets(size_t cap, alloc& cur_alloc,
+                    bucket_alloc& cur_bucket_alloc, size_t threads, Fill&& fill,
+                    Destroy&& destroy);
+
+  T** build_copy(const Deque& other, alloc& cur_alloc,
+                 bucket_alloc& cur_bucket_alloc, size_t threads);
+
+  void destroy_range(size_t bucket_num, size_t from, size_t to);
+
+  struct Slab {
+    std::atomic<size_t> refs;
+    T* ptr;
+    size_t buckets;
+    Allocator alloc;
+  };
+
+  struct SharedBucket {
+    std::atomic<size_t> refs;
+    T* bucket;
+    size_t lo;
+    size_t hi;
+    Allocator alloc;
+    Slab* slab;
+  };
+
+  static void release(SharedBucket* shared);
+
+  static void release(Slab* slab);
+
+  bool in_slab(const T* bucket) const {
+    return slab_ != nullptr && !std::less<const T*>()(bucket, slab_->ptr) &&
+           std::less<const T*>()(bucket,
+                                 slab_->ptr + slab_->buckets * kBucketSize);
+  }
+
+  bool contiguous() const {
+    return first_bucket_ == last_bucket_ ||
+           (slab_intact_ && in_slab(data_[first_bucket_]) &&
+            in_slab(data_[last_bucket_]));
+  }
+
+  std::vector<SharedBucket*> rebased_shared(size_t new_cap,
+                                            size_t offset) const;
+
+  void detach(size_t bucket_num);
+
+  bool reclaim(size_t bucket_num);
+
+  void drop_shared(size_t bucket_num);
+
+  iterator owned(iterator iter) {
+    iter.owner_ = this;
+    return iter;
+  }
+
+  void detach_all() {
+    if (shared_cnt_ == 0) {
+      return;
+    }
+    for (size_t i = 0; i < bucket_cnt_; ++i) {
+      detach(i);
+    }
+  }
+
+  bool is_shared(size_t bucket_num) const {
+    return shared_cnt_ != 0 && shared_[bucket_num] != nullptr;
+  }
+
+  template <typename F>
+  static void run_parallel(size_t threads, size_t count, F&& func);
+
+  template <typename Compare>
+  void sort_runs(Compare comp, Parallel par, bool stable);
 
   alloc alloc_;
   bucket_alloc bucket_alloc_;
@@ -158,24 +391,334 @@ class Deque {
   size_t last_bucket_ = 0;
   size_t first_pos_ = 0;
   size_t last_pos_ = 0;
+  std::vector<SharedBucket*> shared_;
+  size_t shared_cnt_ = 0;
+  long long front_seq_ = 0;
+  long long front_low_ = std::numeric_limits<long long>::max();
+  long long back_high_ = std::numeric_limits<long long>::min();
+  long long front_epoch_ = 0;
+  long long back_epoch_ = 0;
+  std::vector<Reuse> front_reuses_;
+  std::vector<Reuse> back_reuses_;
+  Slab* slab_ = nullptr;
+  bool slab_intact_ = false;
 };
 
 template <typename T, typename Allocator>
-void Deque<T, Allocator>::clear() {
+void Deque<T, Allocator>::clear(Parallel par) {
+  if (data_ != nullptr) {
+    run_parallel(par.threads, bucket_cnt_, [this](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i) {
+        if (is_shared(i)) {
+          release(shared_[i]);
+          continue;
+        }
+        auto [from, to] = live_range(i);
+        destroy_range(i, from, to);
+        if (!in_slab(data_[i])) {
+          alloc_traits::deallocate(alloc_, data_[i], kBucketSize);
+        }
+      }
+    });
+    bucket_alloc_traits::deallocate(bucket_alloc_, data_, bucket_cnt_);
+  }
+  if (slab_ != nullptr) {
+    release(slab_);
+    slab_ = nullptr;
+  }
+  slab_intact_ = false;
+  front_low_ = std::min(front_low_, front_seq_);
+  back_high_ = std::max(back_high_, back_seq());
+  front_seq_ = back_seq();
+  data_ = nullptr;
+  size_ = 0;
+  bucket_cnt_ = 0;
+  first_bucket_ = 0;
+  last_bucket_ = 0;
+  first_pos_ = 0;
+  last_pos_ = 0;
+  shared_.clear();
+  shared_cnt_ = 0;
+}
+
+template <typename T, typename Allocator>
+template <typename Fill, typename Destroy>
+T** Deque<T, Allocator>::build_buckets(size_t cap, alloc& cur_alloc,
+                                       bucket_alloc& cur_bucket_alloc,
+                                       size_t threads, Fill&& fill,
+                                       Destroy&& destroy) {
+  if (cap == 0) {
+    return nullptr;
+  }
+  T** new_data = bucket_alloc_traits::allocate(cur_bucket_alloc, cap);
+  std::vector<char> built;
+  try {
+    built.assign(cap, 0);
+    run_parallel(threads, cap, [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i) {
+        new_data[i] = alloc_traits::allocate(cur_alloc, kBucketSize);
+        try {
+          fill(new_data[i], i);
+        } catch (...) {
+          alloc_traits::deallocate(cur_alloc, new_data[i], kBucketSize);
+          throw;
+        }
+        built[i] = 1;
+      }
+    });
+  } catch (...) {
+    for (size_t i = 0; i < built.size(); ++i) {
+      if (built[i] != 0) {
+        destroy(new_data[i], i);
+        alloc_traits::deallocate(cur_alloc, new_data[i], kBucketSize);
+      }
+    }
+    bucket_alloc_traits::deallocate(cur_bucket_alloc, new_data, cap);
+    throw;
+  }
+  return new_data;
+}
+
+template <typename T, typename Allocator>
+T** Deque<T, Allocator>::build_copy(const Deque& other, alloc& cur_alloc,
+                                    bucket_alloc& cur_bucket_alloc,
+                                    size_t threads) {
+  auto destroy = [&](T* bucket, size_t from, size_t to) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (size_t j = from; j < to; ++j) {
+        alloc_traits::destroy(cur_alloc, bucket + j);
+      }
+    }
+  };
+  return build_buckets(
+      other.bucket_cnt_, cur_alloc, cur_bucket_alloc, threads,
+      [&](T* bucket, size_t bucket_num) {
+        auto [from, to] = other.live_range(bucket_num);
+        size_t j = from;
+        try {
+          for (; j < to; ++j) {
+            alloc_traits::construct(cur_alloc, bucket + j,
+                                    other.data_[bucket_num][j]);
+          }
+        } catch (...) {
+          destroy(bucket, from, j);
+          throw;
+        }
+      },
+      [&](T* bucket, size_t bucket_num) {
+        auto [from, to] = other.live_range(bucket_num);
+        destroy(bucket, from, to);
+      });
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::destroy_range(size_t bucket_num, size_t from,
+                                        size_t to) {
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    if (is_shared(bucket_num)) {
+      return;
+    }
+    for (size_t j = from; j < to; ++j) {
+      alloc_traits::destroy(alloc_, data_[bucket_num] + j);
+    }
+  }
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::release(SharedBucket* shared) {
+  if (shared->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+  for (size_t j = shared->lo; j < shared->hi; ++j) {
+    alloc_traits::destroy(shared->alloc, shared->bucket + j);
+  }
+  if (shared->slab != nullptr) {
+    release(shared->slab);
+  } else {
+    alloc_traits::deallocate(shared->alloc, shared->bucket, kBucketSize);
+  }
+  delete shared;
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::release(Slab* slab) {
+  if (slab->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+  alloc_traits::deallocate(slab->alloc, slab->ptr,
+                           slab->buckets * kBucketSize);
+  delete slab;
+}
+
+template <typename T, typename Allocator>
+std::vector<typename Deque<T, Allocator>::SharedBucket*>
+Deque<T, Allocator>::rebased_shared(size_t new_cap, size_t offset) const {
+  std::vector<SharedBucket*> next;
+  if (shared_cnt_ == 0) {
+    return next;
+  }
+  next.assign(new_cap, nullptr);
   for (size_t i = 0; i < bucket_cnt_; ++i) {
-    for (size_t j = 0; j < kBucketSize; ++j) {
-      if (is_index_inside(i, j)) {
-        alloc_traits::destroy(alloc_, data_[i] + j);
+    next[offset + i] = shared_[i];
+  }
+  return next;
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::detach(size_t bucket_num) {
+  if constexpr (std::is_copy_constructible_v<T>) {
+    if (!is_shared(bucket_num) || reclaim(bucket_num)) {
+      return;
+    }
+    T* bucket = alloc_traits::allocate(alloc_, kBucketSize);
+    size_t elem_ind = 0;
+    try {
+      for (; elem_ind < kBucketSize; ++elem_ind) {
+        if (is_index_inside(bucket_num, elem_ind)) {
+          alloc_traits::construct(alloc_, bucket + elem_ind,
+                                  data_[bucket_num][elem_ind]);
+        }
+      }
+    } catch (...) {
+      for (size_t j = 0; j < elem_ind; ++j) {
+        if (is_index_inside(bucket_num, j)) {
+          alloc_traits::destroy(alloc_, bucket + j);
+        }
+      }
+      alloc_traits::deallocate(alloc_, bucket, kBucketSize);
+      throw;
+    }
+    if (in_slab(data_[bucket_num])) {
+      slab_intact_ = false;
+    }
+    release(shared_[bucket_num]);
+    shared_[bucket_num] = nullptr;
+    --shared_cnt_;
+    data_[bucket_num] = bucket;
+  }
+}
+
+template <typename T, typename Allocator>
+bool Deque<T, Allocator>::reclaim(size_t bucket_num) {
+  SharedBucket* shared = shared_[bucket_num];
+  if (shared->refs.load(std::memory_order_acquire) != 1) {
+    return false;
+  }
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    auto [from, to] = live_range(bucket_num);
+    for (size_t j = shared->lo; j < shared->hi; ++j) {
+      if (j < from || j >= to) {
+        alloc_traits::destroy(alloc_, data_[bucket_num] + j);
       }
     }
-    alloc_traits::deallocate(alloc_, data_[i], kBucketSize);
   }
-  bucket_alloc_traits::deallocate(bucket_alloc_, data_, bucket_cnt_);
+  if (shared->slab != nullptr) {
+    release(shared->slab);
+  }
+  delete shared;
+  shared_[bucket_num] = nullptr;
+  --shared_cnt_;
+  return true;
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::drop_shared(size_t bucket_num) {
+  if (!is_shared(bucket_num)) {
+    return;
+  }
+  auto [from, to] = live_range(bucket_num);
+  if (from < to || reclaim(bucket_num)) {
+    return;
+  }
+  T* bucket = nullptr;
+  try {
+    bucket = alloc_traits::allocate(alloc_, kBucketSize);
+  } catch (...) {
+    return;
+  }
+  if (in_slab(data_[bucket_num])) {
+    slab_intact_ = false;
+  }
+  release(shared_[bucket_num]);
+  shared_[bucket_num] = nullptr;
+  --shared_cnt_;
+  data_[bucket_num] = bucket;
+}
+
+template <typename T, typename Allocator>
+template <typename F>
+void Deque<T, Allocator>::for_each_segment(F&& func) {
+  if (size_ == 0) {
+    return;
+  }
+  detach_all();
+  for (size_t i = first_bucket_; i <= last_bucket_; ++i) {
+    size_t lo = i == first_bucket_ ? first_pos_ : 0;
+    size_t hi = i == last_bucket_ ? last_pos_ + 1 : kBucketSize;
+    func(data_[i] + lo, hi - lo);
+  }
+}
+
+template <typename T, typename Allocator>
+template <typename F>
+void Deque<T, Allocator>::for_each_segment(F&& func) const {
+  if (size_ == 0) {
+    return;
+  }
+  for (size_t i = first_bucket_; i <= last_bucket_; ++i) {
+    size_t lo = i == first_bucket_ ? first_pos_ : 0;
+    size_t hi = i == last_bucket_ ? last_pos_ + 1 : kBucketSize;
+    const T* bucket = data_[i];
+    func(bucket + lo, hi - lo);
+  }
+}
+
+template <typename T, typename Allocator>
+template <typename F>
+void Deque<T, Allocator>::run_parallel(size_t threads, size_t count,
+                                       F&& func) {
+  threads = std::min(std::max<size_t>(threads, 1), count);
+  if (threads <= 1) {
+    func(0, count);
+    return;
+  }
+  std::vector<std::exception_ptr> errors(threads);
+  auto run = [&func, &errors, threads, count](size_t t) {
+    try {
+      func(count * t / threads, count * (t + 1) / threads);
+    } catch (...) {
+      errors[t] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> workers;
+  size_t spawned = 1;
+  try {
+    workers.reserve(threads - 1);
+    for (; spawned < threads; ++spawned) {
+      workers.emplace_back(run, spawned);
+    }
+  } catch (...) {
+  }
+  for (size_t t = spawned; t < threads; ++t) {
+    run(t);
+  }
+  run(0);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
 }
 
 template <typename T, typename Allocator>
 bool Deque<T, Allocator>::is_index_inside(size_t bucket_num,
                                           size_t elem_num) const {
+  if (size_ == 0) {
+    return false;
+  }
   if (first_bucket_ == last_bucket_) {
     return bucket_num == first_bucket_ && elem_num >= first_pos_ &&
            elem_num <= last_pos_;
@@ -206,9 +749,15 @@ class Deque<T, Allocator>::BaseIterator {
 
   BaseIterator& operator=(const BaseIterator& other) = default;
 
-  reference operator*() const { return ptr_[bucket_ind_][elem_ind_]; }
+  reference operator*() const {
+    writable();
+    return ptr_[bucket_ind_][elem_ind_];
+  }
 
-  pointer operator->() const { return ptr_[bucket_ind_] + elem_ind_; }
+  pointer operator->() const {
+    writable();
+    return ptr_[bucket_ind_] + elem_ind_;
+  }
 
   BaseIterator& operator-=(int cnt);
 
@@ -249,31 +798,240 @@ class Deque<T, Allocator>::BaseIterator {
   difference_type operator-(BaseIterator rhs);
 
  private:
+  friend class Deque;
+
+  void writable() const {
+    if constexpr (!IsConst) {
+      if (owner_ != nullptr && owner_->shared_cnt_ != 0) {
+        owner_->detach(static_cast<size_t>(bucket_ind_));
+      }
+    }
+  }
+
   buckets_type_ptr ptr_ = nullptr;
   int bucket_ind_ = 0;
   int elem_ind_ = 0;
+  Deque* owner_ = nullptr;
 };
 
 template <typename T, typename Allocator>
-template <bool IsConst>
-Deque<T, Allocator>::BaseIterator<IsConst>::BaseIterator(
-    typename Deque<T, Allocator>::BaseIterator<IsConst>::buckets_type_ptr ptr,
-    int bucket_ind, int elem_ind, size_t size)
-    : ptr_(ptr) {
-  if (size == 0) {
-    bucket_ind_ = elem_ind_ = 0;
+template <bool IsConst>
+Deque<T, Allocator>::BaseIterator<IsConst>::BaseIterator(
+    typename Deque<T, Allocator>::BaseIterator<IsConst>::buckets_type_ptr ptr,
+    int bucket_ind, int elem_ind, size_t size)
+    : ptr_(ptr) {
+  if (size == 0) {
+    bucket_ind_ = elem_ind_ = 0;
+    return;
+  }
+  if (elem_ind >= static_cast<int>(Deque<T, Allocator>::kBucketSize)) {
+    ++bucket_ind;
+    elem_ind = 0;
+  }
+  if (elem_ind < 0) {
+    --bucket_ind;
+    elem_ind = static_cast<int>(Deque<T, Allocator>::kBucketSize) - 1;
+  }
+  elem_ind_ = elem_ind;
+  bucket_ind_ = bucket_ind;
+}
+
+template <typename T, typename Allocator>
+class Deque<T, Allocator>::Snapshot {
+ public:
+  Snapshot() = default;
+
+  Snapshot(const Snapshot& other);
+
+  Snapshot(Snapshot&& other) noexcept;
+
+  ~Snapshot();
+
+  Snapshot& operator=(const Snapshot& other);
+
+  Snapshot& operator=(Snapshot&& other) noexcept;
+
+  [[nodiscard]] size_t size() const { return size_; }
+
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+
+  const T& operator[](size_t ind) const {
+    size_t pos = first_pos_ + ind;
+    return blocks_[pos / kBucketSize][pos % kBucketSize];
+  }
+
+  const T& at(size_t ind) const;
+
+  const_iterator begin() const { return cbegin(); }
+
+  const_iterator end() const { return cend(); }
+
+  const_iterator cbegin() const {
+    return const_iterator(const_cast<const T**>(blocks_.data()), 0,
+                          static_cast<int>(first_pos_), size_);
+  }
+
+  const_iterator cend() const {
+    size_t last = first_pos_ + size_ - 1;
+    return const_iterator(const_cast<const T**>(blocks_.data()),
+                          static_cast<int>(last / kBucketSize),
+                          static_cast<int>(last % kBucketSize) + 1, size_);
+  }
+
+  template <typename F>
+  void for_each_segment(F&& func) const;
+
+ private:
+  friend class Deque;
+
+  void swap(Snapshot& other) noexcept;
+
+  std::vector<SharedBucket*> shared_;
+  std::vector<const T*> blocks_;
+  size_t first_pos_ = 0;
+  size_t size_ = 0;
+};
+
+template <typename T, typename Allocator>
+Deque<T, Allocator>::Snapshot::Snapshot(const Snapshot& other)
+    : shared_(other.shared_),
+      blocks_(other.blocks_),
+      first_pos_(other.first_pos_),
+      size_(other.size_) {
+  for (auto* shared : shared_) {
+    shared->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+template <typename T, typename Allocator>
+Deque<T, Allocator>::Snapshot::Snapshot(Snapshot&& other) noexcept {
+  swap(other);
+}
+
+template <typename T, typename Allocator>
+Deque<T, Allocator>::Snapshot::~Snapshot() {
+  for (auto* shared : shared_) {
+    release(shared);
+  }
+}
+
+template <typename T, typename Allocator>
+typename Deque<T, Allocator>::Snapshot& Deque<T, Allocator>::Snapshot::operator=(
+    const Snapshot& other) {
+  if (&other != this) {
+    Snapshot tmp(other);
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename T, typename Allocator>
+typename Deque<T, Allocator>::Snapshot& Deque<T, Allocator>::Snapshot::operator=(
+    Snapshot&& other) noexcept {
+  if (&other != this) {
+    Snapshot tmp(std::move(other));
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::Snapshot::swap(Snapshot& other) noexcept {
+  shared_.swap(other.shared_);
+  blocks_.swap(other.blocks_);
+  std::swap(first_pos_, other.first_pos_);
+  std::swap(size_, other.size_);
+}
+
+template <typename T, typename Allocator>
+const T& Deque<T, Allocator>::Snapshot::at(size_t ind) const {
+  if (ind >= size_) {
+    throw std::out_of_range("Index out of range!");
+  }
+  return operator[](ind);
+}
+
+template <typename T, typename Allocator>
+template <typename F>
+void Deque<T, Allocator>::Snapshot::for_each_segment(F&& func) const {
+  size_t left = size_;
+  for (size_t i = 0; i < blocks_.size() && left > 0; ++i) {
+    size_t lo = i == 0 ? first_pos_ : 0;
+    size_t len = std::min(kBucketSize - lo, left);
+    func(blocks_[i] + lo, len);
+    left -= len;
+  }
+}
+
+template <typename T, typename Allocator>
+typename Deque<T, Allocator>::Snapshot Deque<T, Allocator>::snapshot()
+  requires std::is_copy_constructible_v<T>
+{
+  Snapshot result;
+  if (size_ == 0) {
+    return result;
+  }
+  if (shared_.size() != bucket_cnt_) {
+    shared_.assign(bucket_cnt_, nullptr);
+  }
+  result.shared_.reserve(last_bucket_ - first_bucket_ + 1);
+  result.blocks_.reserve(last_bucket_ - first_bucket_ + 1);
+  result.first_pos_ = first_pos_;
+  result.size_ = size_;
+  for (size_t i = first_bucket_; i <= last_bucket_; ++i) {
+    if (shared_[i] == nullptr) {
+      size_t lo = i == first_bucket_ ? first_pos_ : 0;
+      size_t hi = i == last_bucket_ ? last_pos_ + 1 : kBucketSize;
+      Slab* slab = in_slab(data_[i]) ? slab_ : nullptr;
+      shared_[i] = new SharedBucket{1, data_[i], lo, hi, alloc_, slab};
+      ++shared_cnt_;
+      if (slab != nullptr) {
+        slab->refs.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    shared_[i]->refs.fetch_add(1, std::memory_order_relaxed);
+    result.shared_.push_back(shared_[i]);
+    result.blocks_.push_back(data_[i]);
+  }
+  return result;
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::recycle_front() {
+  if (first_bucket_ == 0) {
     return;
   }
-  if (elem_ind >= static_cast<int>(Deque<T, Allocator>::kBucketSize)) {
-    ++bucket_ind;
-    elem_ind = 0;
+  size_t shift = size_ == 0 && first_pos_ == 0 ? first_bucket_ - 1
+                                                : first_bucket_;
+  if (shift == 0 || shift * 2 < bucket_cnt_) {
+    return;
   }
-  if (elem_ind < 0) {
-    --bucket_ind;
-    elem_ind = static_cast<int>(Deque<T, Allocator>::kBucketSize) - 1;
+  std::rotate(data_, data_ + shift, data_ + bucket_cnt_);
+  if (shared_.size() == bucket_cnt_) {
+    std::rotate(shared_.begin(), shared_.begin() + shift, shared_.end());
+  }
+  first_bucket_ -= shift;
+  last_bucket_ -= shift;
+  if (slab_ != nullptr) {
+    slab_intact_ = false;
+  }
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::recycle_back() {
+  size_t shift = bucket_cnt_ - 1 - last_bucket_;
+  if (shift == 0 || shift * 2 < bucket_cnt_) {
+    return;
+  }
+  std::rotate(data_, data_ + bucket_cnt_ - shift, data_ + bucket_cnt_);
+  if (shared_.size() == bucket_cnt_) {
+    std::rotate(shared_.begin(), shared_.end() - shift, shared_.end());
+  }
+  first_bucket_ += shift;
+  last_bucket_ += shift;
+  if (slab_ != nullptr) {
+    slab_intact_ = false;
   }
-  elem_ind_ = elem_ind;
-  bucket_ind_ = bucket_ind;
 }
 
 template <typename T, typename Allocator>
@@ -315,47 +1073,107 @@ T** Deque<T, Allocator>::reserve(size_t new_cap, alloc& cur_alloc,
 }
 
 template <typename T, typename Allocator>
-Deque<T, Allocator>::Deque(const Allocator& alloc) : alloc_(alloc) {}
+void Deque<T, Allocator>::grow_map(size_t front_buckets, size_t back_buckets) {
+  size_t new_cap = bucket_cnt_ + front_buckets + back_buckets;
+  auto next_shared = rebased_shared(new_cap, front_buckets);
+  T** new_data = bucket_alloc_traits::allocate(bucket_alloc_, new_cap);
+  size_t added = 0;
+  try {
+    for (; added < front_buckets + back_buckets; ++added) {
+      size_t ind = added < front_buckets ? added : added + bucket_cnt_;
+      new_data[ind] = alloc_traits::allocate(alloc_, kBucketSize);
+    }
+  } catch (...) {
+    for (size_t i = 0; i < added; ++i) {
+      size_t ind = i < front_buckets ? i : i + bucket_cnt_;
+      alloc_traits::deallocate(alloc_, new_data[ind], kBucketSize);
+    }
+    bucket_alloc_traits::deallocate(bucket_alloc_, new_data, new_cap);
+    throw;
+  }
+  for (size_t i = 0; i < bucket_cnt_; ++i) {
+    new_data[front_buckets + i] = data_[i];
+  }
+  if (data_ == nullptr) {
+    first_bucket_ = front_buckets;
+    first_pos_ = 0;
+    last_bucket_ = front_buckets - 1;
+    last_pos_ = kBucketSize - 1;
+  } else {
+    bucket_alloc_traits::deallocate(bucket_alloc_, data_, bucket_cnt_);
+    first_bucket_ += front_buckets;
+    last_bucket_ += front_buckets;
+  }
+  data_ = new_data;
+  shared_.swap(next_shared);
+  bucket_cnt_ = new_cap;
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::reserve_back(size_t count) {
+  size_t free = capacity_back();
+  if (free >= count) {
+    return;
+  }
+  size_t buckets = (count - free - 1) / kBucketSize + 1;
+  grow_map(data_ == nullptr ? 1 : 0, buckets);
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::reserve_front(size_t count) {
+  size_t free = capacity_front();
+  if (free >= count) {
+    return;
+  }
+  size_t buckets = (count - free - 1) / kBucketSize + 1;
+  grow_map(buckets, data_ == nullptr ? 1 : 0);
+}
+
+template <typename T, typename Allocator>
+size_t Deque<T, Allocator>::capacity_back() const {
+  if (data_ == nullptr) {
+    return 0;
+  }
+  return (bucket_cnt_ - 1 - last_bucket_) * kBucketSize +
+         (kBucketSize - 1 - last_pos_);
+}
+
+template <typename T, typename Allocator>
+size_t Deque<T, Allocator>::capacity_front() const {
+  if (data_ == nullptr) {
+    return 0;
+  }
+  return first_bucket_ * kBucketSize + first_pos_;
+}
+
+template <typename T, typename Allocator>
+Deque<T, Allocator>::Deque(const Allocator& alloc)
+    : alloc_(alloc), bucket_alloc_(alloc) {}
 
 template <typename T, typename Allocator>
-Deque<T, Allocator>::Deque(const Deque& other)
+Deque<T, Allocator>::Deque(const Deque& other) : Deque(other, Parallel{1}) {}
+
+template <typename T, typename Allocator>
+Deque<T, Allocator>::Deque(const Deque& other, Parallel par)
     : size_(other.size_),
       first_bucket_(other.first_bucket_),
       last_bucket_(other.last_bucket_),
       first_pos_(other.first_pos_),
-      last_pos_(other.last_pos_) {
+      last_pos_(other.last_pos_),
+      front_seq_(other.front_seq_) {
   alloc_ = alloc_traits::select_on_container_copy_construction(other.alloc_);
   bucket_alloc_ = bucket_alloc_traits::select_on_container_copy_construction(
       other.bucket_alloc_);
-  data_ = reserve(other.bucket_cnt_, alloc_, bucket_alloc_);
+  data_ = build_copy(other, alloc_, bucket_alloc_, par.threads);
   bucket_cnt_ = other.bucket_cnt_;
-  size_t bucket_ind = 0;
-  size_t elem_ind = 0;
-  try {
-    for (size_t i = 0; i < other.bucket_cnt_; ++i) {
-      bucket_ind = i;
-      for (size_t j = 0; j < kBucketSize; ++j) {
-        elem_ind = j;
-        alloc_traits::construct(alloc_, data_[i] + j, other.data_[i][j]);
-      }
-    }
-  } catch (...) {
-    for (size_t i = 0; i < bucket_cnt_; ++i) {
-      for (size_t j = 0; j < kBucketSize; ++j) {
-        if (i < bucket_ind || (i == bucket_ind && j < elem_ind)) {
-          alloc_traits::destroy(alloc_, data_[i] + j);
-        }
-      }
-      alloc_traits::deallocate(alloc_, data_[i], kBucketSize);
-    }
-    bucket_alloc_traits::deallocate(bucket_alloc_, data_, bucket_cnt_);
-    throw;
-  }
 }
 
 template <typename T, typename Allocator>
 Deque<T, Allocator>::Deque(size_t count, const Allocator& alloc)
-    : alloc_(alloc), size_(count), last_pos_((count - 1) % kBucketSize) {
+    : alloc_(alloc),
+      bucket_alloc_(alloc),
+      size_(count),
+      last_pos_((count - 1) % kBucketSize) {
   if (count == 0) {
     return;
   }
@@ -390,48 +1208,69 @@ Deque<T, Allocator>::Deque(size_t count, const Allocator& alloc)
 
 template <typename T, typename Allocator>
 Deque<T, Allocator>::Deque(size_t count, const T& value, const Allocator& alloc)
-    : alloc_(alloc), size_(count), last_pos_((count - 1) % kBucketSize) {
+    : Deque(count, value, Parallel{1}, alloc) {}
+
+template <typename T, typename Allocator>
+Deque<T, Allocator>::Deque(size_t count, const T& value, Parallel par,
+                           const Allocator& alloc)
+    : alloc_(alloc),
+      bucket_alloc_(alloc),
+      size_(count),
+      last_pos_((count - 1) % kBucketSize) {
   if (count == 0) {
     return;
   }
-  data_ = reserve((count - 1) / kBucketSize + 1, alloc_, bucket_alloc_);
-  bucket_cnt_ = (count - 1) / kBucketSize + 1;
-  last_bucket_ = bucket_cnt_ - 1;
-  size_t bucket_ind = 0;
-  size_t elem_ind = 0;
-  try {
-    for (size_t i = 0; i < bucket_cnt_; ++i) {
-      bucket_ind = i;
-      for (size_t j = 0; j < kBucketSize; ++j) {
-        if (i * kBucketSize + j + 1 <= count) {
-          elem_ind = j;
-          alloc_traits::construct(alloc_, data_[i] + j, value);
-        }
+  size_t cap = (count - 1) / kBucketSize + 1;
+  auto destroy = [this](T* bucket, size_t to) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (size_t j = 0; j < to; ++j) {
+        alloc_traits::destroy(alloc_, bucket + j);
       }
     }
-  } catch (...) {
-    for (size_t i = 0; i < bucket_cnt_; ++i) {
-      for (size_t j = 0; j < kBucketSize; ++j) {
-        if (i < bucket_ind || (i == bucket_ind && j < elem_ind)) {
-          alloc_traits::destroy(alloc_, data_[i] + j);
+  };
+  auto filled = [count](size_t bucket_num) {
+    size_t left = count - bucket_num * kBucketSize;
+    return left < kBucketSize ? left : kBucketSize;
+  };
+  data_ = build_buckets(
+      cap, alloc_, bucket_alloc_, par.threads,
+      [&](T* bucket, size_t bucket_num) {
+        size_t j = 0;
+        try {
+          for (; j < filled(bucket_num); ++j) {
+            alloc_traits::construct(alloc_, bucket + j, value);
+          }
+        } catch (...) {
+          destroy(bucket, j);
+          throw;
         }
-      }
-      alloc_traits::deallocate(alloc_, data_[i], kBucketSize);
-    }
-    bucket_alloc_traits::deallocate(bucket_alloc_, data_, bucket_cnt_);
-    throw;
-  }
+      },
+      [&](T* bucket, size_t bucket_num) {
+        destroy(bucket, filled(bucket_num));
+      });
+  bucket_cnt_ = cap;
+  last_bucket_ = bucket_cnt_ - 1;
 }
 
 template <typename T, typename Allocator>
 Deque<T, Allocator>::Deque(Deque<T, Allocator>&& other) noexcept
-    : data_(other.data_),
+    : alloc_(other.alloc_),
+      bucket_alloc_(other.bucket_alloc_),
+      data_(other.data_),
       size_(other.size_),
       bucket_cnt_(other.bucket_cnt_),
       first_bucket_(other.first_bucket_),
       last_bucket_(other.last_bucket_),
       first_pos_(other.first_pos_),
-      last_pos_(other.last_pos_) {
+      last_pos_(other.last_pos_),
+      shared_(std::move(other.shared_)),
+      shared_cnt_(other.shared_cnt_),
+      front_seq_(other.front_seq_),
+      slab_(other.slab_),
+      slab_intact_(other.slab_intact_) {
+  other.shared_cnt_ = 0;
+  other.slab_ = nullptr;
+  other.slab_intact_ = false;
   other.data_ = nullptr;
   other.size_ = 0;
   other.bucket_cnt_ = 0;
@@ -445,6 +1284,7 @@ template <typename T, typename Allocator>
 Deque<T, Allocator>::Deque(std::initializer_list<T> init,
                            const Allocator& alloc)
     : alloc_(alloc),
+      bucket_alloc_(alloc),
       size_(init.size()),
       last_pos_((init.size() - 1) % kBucketSize) {
   if (init.size() == 0) {
@@ -488,6 +1328,12 @@ Deque<T, Allocator>::~Deque() {
 
 template <typename T, typename Allocator>
 Deque<T, Allocator>& Deque<T, Allocator>::operator=(const Deque& other) {
+  return assign(other, Parallel{1});
+}
+
+template <typename T, typename Allocator>
+Deque<T, Allocator>& Deque<T, Allocator>::assign(const Deque& other,
+                                                 Parallel par) {
   if (&other == this) {
     return *this;
   }
@@ -500,39 +1346,8 @@ Deque<T, Allocator>& Deque<T, Allocator>::operator=(const Deque& other) {
     next_bucket_alloc = other.bucket_alloc_;
   }
   T** new_data =
-      bucket_alloc_traits::allocate(next_bucket_alloc, other.bucket_cnt_);
-  for (size_t i = 0; i < other.bucket_cnt_; ++i) {
-    new_data[i] = alloc_traits::allocate(next_alloc, kBucketSize);
-  }
-  size_t bucket_ind = 0;
-  size_t elem_ind = 0;
-  auto other_it = other.cbegin();
-  try {
-    for (size_t i = 0; i < other.bucket_cnt_; ++i) {
-      bucket_ind = i;
-      for (size_t j = 0; j < kBucketSize; ++j) {
-        if (other.is_index_inside(i, j)) {
-          elem_ind = j;
-          alloc_traits::construct(next_alloc, new_data[i] + j, *other_it);
-          ++other_it;
-        }
-      }
-    }
-  } catch (...) {
-    for (size_t i = 0; i < other.bucket_cnt_; ++i) {
-      for (size_t j = 0; j < kBucketSize; ++j) {
-        if (other.is_index_inside(i, j) &&
-            (i < bucket_ind || (i == bucket_ind && j < elem_ind))) {
-          alloc_traits::destroy(next_alloc, new_data[i] + j);
-        }
-      }
-      alloc_traits::deallocate(next_alloc, new_data[i], kBucketSize);
-    }
-    bucket_alloc_traits::deallocate(next_bucket_alloc, new_data,
-                                    other.bucket_cnt_);
-    throw;
-  }
-  clear();
+      build_copy(other, next_alloc, next_bucket_alloc, par.threads);
+  clear(par);
   data_ = new_data;
   alloc_ = next_alloc;
   bucket_alloc_ = next_bucket_alloc;
@@ -542,6 +1357,7 @@ Deque<T, Allocator>& Deque<T, Allocator>::operator=(const Deque& other) {
   last_bucket_ = other.last_bucket_;
   first_pos_ = other.first_pos_;
   last_pos_ = other.last_pos_;
+  invalidate_handles();
   return *this;
 }
 
@@ -584,13 +1400,13 @@ bool Deque<T, Allocator>::empty() const {
 template <typename T, typename Allocator>
 T& Deque<T, Allocator>::operator[](int ind) {
   if (ind <= static_cast<int>(kBucketSize - first_pos_ - 1)) {
+    detach(first_bucket_);
     return data_[first_bucket_][first_pos_ + ind];
   }
-  int bucket_ind = (ind - (static_cast<int>(kBucketSize - first_pos_)) - 1) /
-                       static_cast<int>(kBucketSize) +
-                   1;
-  int elem_ind = (ind - (static_cast<int>(kBucketSize - first_pos_))) %
-                 static_cast<int>(kBucketSize);
+  int offset = ind - static_cast<int>(kBucketSize - first_pos_);
+  int bucket_ind = offset / static_cast<int>(kBucketSize) + 1;
+  int elem_ind = offset % static_cast<int>(kBucketSize);
+  detach(first_bucket_ + bucket_ind);
   return data_[static_cast<int>(first_bucket_) + bucket_ind][elem_ind];
 }
 
@@ -599,11 +1415,9 @@ const T& Deque<T, Allocator>::operator[](int ind) const {
   if (ind <= static_cast<int>(kBucketSize - first_pos_ - 1)) {
     return data_[first_bucket_][first_pos_ + ind];
   }
-  int bucket_ind = (ind - (static_cast<int>(kBucketSize - first_pos_)) - 1) /
-                       static_cast<int>(kBucketSize) +
-                   1;
-  int elem_ind = (ind - (static_cast<int>(kBucketSize - first_pos_))) %
-                 static_cast<int>(kBucketSize);
+  int offset = ind - static_cast<int>(kBucketSize - first_pos_);
+  int bucket_ind = offset / static_cast<int>(kBucketSize) + 1;
+  int elem_ind = offset % static_cast<int>(kBucketSize);
   return data_[static_cast<int>(first_bucket_) + bucket_ind][elem_ind];
 }
 
@@ -626,6 +1440,17 @@ const T& Deque<T, Allocator>::at(size_t ind) const {
 template <typename T, typename Allocator>
 template <typename... Args>
 void Deque<T, Allocator>::emplace_front(Args&&... args) {
+  if (front_seq_ - 1 >= front_low_) {
+    reuse_front(front_seq_ - 1);
+  }
+  if (first_pos_ == 0 && first_bucket_ == 0 && data_ != nullptr) {
+    recycle_back();
+  }
+  if (first_pos_ > 0) {
+    detach(first_bucket_);
+  } else if (first_bucket_ > 0) {
+    detach(first_bucket_ - 1);
+  }
   if (first_pos_ > 0) {
     try {
       alloc_traits::construct(alloc_, data_[first_bucket_] + first_pos_ - 1,
@@ -664,13 +1489,17 @@ void Deque<T, Allocator>::emplace_front(Args&&... args) {
       last_pos_ = first_pos_;
       size_ = 1;
       bucket_cnt_ = 3;
+      --front_seq_;
       return;
     }
 
     size_t next_capacity = bucket_cnt_ * 2 + 1;
+    auto next_shared =
+        rebased_shared(next_capacity, (next_capacity - bucket_cnt_) / 2);
     T** new_data = reserve(next_capacity, alloc_, bucket_alloc_);
     bucket_alloc_traits::deallocate(bucket_alloc_, data_, bucket_cnt_);
     data_ = new_data;
+    shared_.swap(next_shared);
     try {
       alloc_traits::construct(
           alloc_,
@@ -685,6 +1514,7 @@ void Deque<T, Allocator>::emplace_front(Args&&... args) {
     bucket_cnt_ = next_capacity;
   }
   ++size_;
+  --front_seq_;
 }
 
 template <typename T, typename Allocator>
@@ -700,6 +1530,9 @@ void Deque<T, Allocator>::push_front(T&& value) {
 template <typename T, typename Allocator>
 template <typename... Args>
 void Deque<T, Allocator>::emplace_back(Args&&... args) {
+  if (back_seq() < back_high_) {
+    reuse_back(back_seq());
+  }
   if (data_ == nullptr) {
     data_ = reserve(3, alloc_, bucket_alloc_);
     try {
@@ -720,6 +1553,14 @@ void Deque<T, Allocator>::emplace_back(Args&&... args) {
     bucket_cnt_ = 3;
     return;
   }
+  if (last_pos_ == kBucketSize - 1 && last_bucket_ == bucket_cnt_ - 1) {
+    recycle_front();
+  }
+  if (last_pos_ < kBucketSize - 1) {
+    detach(last_bucket_);
+  } else if (last_bucket_ < bucket_cnt_ - 1) {
+    detach(last_bucket_ + 1);
+  }
   if (last_pos_ < kBucketSize - 1) {
     try {
       alloc_traits::construct(alloc_, data_[last_bucket_] + last_pos_ + 1,
@@ -739,9 +1580,12 @@ void Deque<T, Allocator>::emplace_back(Args&&... args) {
     last_pos_ = 0;
   } else if (last_bucket_ == bucket_cnt_ - 1) {
     size_t next_capacity = bucket_cnt_ * 2 + 1;
+    auto next_shared =
+        rebased_shared(next_capacity, (next_capacity - bucket_cnt_) / 2);
     T** new_data = reserve(next_capacity, alloc_, bucket_alloc_);
     bucket_alloc_traits::deallocate(bucket_alloc_, data_, bucket_cnt_);
     data_ = new_data;
+    shared_.swap(next_shared);
     try {
       alloc_traits::construct(
           alloc_, data_[last_bucket_ + (next_capacity - bucket_cnt_) / 2 + 1],
@@ -769,26 +1613,258 @@ void Deque<T, Allocator>::push_back(T&& value) {
 
 template <typename T, typename Allocator>
 void Deque<T, Allocator>::pop_back() {
+  back_high_ = std::max(back_high_, back_seq());
+  size_t bucket_num = last_bucket_;
+  if (is_shared(bucket_num)) {
+    reclaim(bucket_num);
+  }
   --size_;
-  alloc_traits::destroy(alloc_, data_[last_bucket_] + last_pos_);
+  if (!is_shared(bucket_num)) {
+    alloc_traits::destroy(alloc_, data_[bucket_num] + last_pos_);
+  }
   if (last_pos_ == 0) {
     last_pos_ = kBucketSize - 1;
-    --last_bucket_;
+    if (last_bucket_ == 0) {
+      first_bucket_ = 1;
+      first_pos_ = 0;
+    } else {
+      --last_bucket_;
+    }
   } else {
     --last_pos_;
   }
+  drop_shared(bucket_num);
 }
 
 template <typename T, typename Allocator>
 void Deque<T, Allocator>::pop_front() {
+  front_low_ = std::min(front_low_, front_seq_);
+  size_t bucket_num = first_bucket_;
+  if (is_shared(bucket_num)) {
+    reclaim(bucket_num);
+  }
   --size_;
-  alloc_traits::destroy(alloc_, data_[first_bucket_] + first_pos_);
+  ++front_seq_;
+  if (!is_shared(bucket_num)) {
+    alloc_traits::destroy(alloc_, data_[bucket_num] + first_pos_);
+  }
   if (first_pos_ == kBucketSize - 1) {
     first_pos_ = 0;
     ++first_bucket_;
   } else {
     ++first_pos_;
   }
+  drop_shared(bucket_num);
+}
+
+template <typename T, typename Allocator>
+std::optional<std::span<T>> Deque<T, Allocator>::try_contiguous() {
+  if (size_ == 0) {
+    return std::span<T>();
+  }
+  if (shared_cnt_ != 0 || !contiguous()) {
+    return std::nullopt;
+  }
+  return std::span<T>(data_[first_bucket_] + first_pos_, size_);
+}
+
+template <typename T, typename Allocator>
+std::optional<std::span<const T>> Deque<T, Allocator>::try_contiguous() const {
+  if (size_ == 0) {
+    return std::span<const T>();
+  }
+  if (!contiguous()) {
+    return std::nullopt;
+  }
+  return std::span<const T>(data_[first_bucket_] + first_pos_, size_);
+}
+
+template <typename T, typename Allocator>
+std::span<T> Deque<T, Allocator>::linearize() {
+  if (auto span = try_contiguous()) {
+    return *span;
+  }
+  size_t live = last_bucket_ - first_bucket_ + 1;
+  size_t cap = live * 2;
+  size_t offset = live / 2;
+  T* ptr = alloc_traits::allocate(alloc_, cap * kBucketSize);
+  Slab* slab = nullptr;
+  T** new_data = nullptr;
+  try {
+    slab = new Slab{1, ptr, cap, alloc_};
+  } catch (...) {
+    alloc_traits::deallocate(alloc_, ptr, cap * kBucketSize);
+    throw;
+  }
+  try {
+    new_data = bucket_alloc_traits::allocate(bucket_alloc_, cap);
+  } catch (...) {
+    release(slab);
+    throw;
+  }
+  auto target = [&](size_t bucket_num) {
+    return ptr + (offset + bucket_num - first_bucket_) * kBucketSize;
+  };
+  size_t bucket_num = first_bucket_;
+  size_t elem_ind = first_pos_;
+  try {
+    for (; bucket_num <= last_bucket_; ++bucket_num) {
+      auto [from, to] = live_range(bucket_num);
+      for (elem_ind = from; elem_ind < to; ++elem_ind) {
+        if constexpr (std::is_copy_constructible_v<T>) {
+          if (is_shared(bucket_num)) {
+            alloc_traits::construct(alloc_, target(bucket_num) + elem_ind,
+                                    data_[bucket_num][elem_ind]);
+            continue;
+          }
+        }
+        alloc_traits::construct(
+            alloc_, target(bucket_num) + elem_ind,
+            std::move_if_noexcept(data_[bucket_num][elem_ind]));
+      }
+    }
+  } catch (...) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (size_t i = first_bucket_; i <= bucket_num; ++i) {
+        auto [from, to] = live_range(i);
+        for (size_t j = from; j < (i == bucket_num ? elem_ind : to); ++j) {
+          alloc_traits::destroy(alloc_, target(i) + j);
+        }
+      }
+    }
+    bucket_alloc_traits::deallocate(bucket_alloc_, new_data, cap);
+    release(slab);
+    throw;
+  }
+
+  for (size_t i = 0; i < bucket_cnt_; ++i) {
+    if (is_shared(i)) {
+      release(shared_[i]);
+    } else {
+      auto [from, to] = live_range(i);
+      destroy_range(i, from, to);
+      if (!in_slab(data_[i])) {
+        alloc_traits::deallocate(alloc_, data_[i], kBucketSize);
+      }
+    }
+  }
+  bucket_alloc_traits::deallocate(bucket_alloc_, data_, bucket_cnt_);
+  if (slab_ != nullptr) {
+    release(slab_);
+  }
+  for (size_t i = 0; i < cap; ++i) {
+    new_data[i] = ptr + i * kBucketSize;
+  }
+  data_ = new_data;
+  bucket_cnt_ = cap;
+  first_bucket_ = offset;
+  last_bucket_ = offset + live - 1;
+  slab_ = slab;
+  slab_intact_ = true;
+  shared_.clear();
+  shared_cnt_ = 0;
+  return std::span<T>(data_[first_bucket_] + first_pos_, size_);
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::pop_back_n(size_t count) {
+  back_high_ = std::max(back_high_, back_seq());
+  size_t left = count;
+  while (left > 0) {
+    size_t bucket_num = last_bucket_;
+    size_t lo = first_bucket_ == last_bucket_ ? first_pos_ : 0;
+    size_t len = std::min(left, last_pos_ + 1 - lo);
+    if (is_shared(bucket_num)) {
+      reclaim(bucket_num);
+    }
+    destroy_range(bucket_num, last_pos_ + 1 - len, last_pos_ + 1);
+    left -= len;
+    if (len == last_pos_ + 1) {
+      last_pos_ = kBucketSize - 1;
+      if (last_bucket_ == 0) {
+        first_bucket_ = 1;
+        first_pos_ = 0;
+      } else {
+        --last_bucket_;
+      }
+    } else {
+      last_pos_ -= len;
+    }
+    drop_shared(bucket_num);
+  }
+  size_ -= count;
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::pop_front_n(size_t count) {
+  front_low_ = std::min(front_low_, front_seq_);
+  front_seq_ += static_cast<long long>(count);
+  size_t left = count;
+  while (left > 0) {
+    size_t bucket_num = first_bucket_;
+    size_t hi = first_bucket_ == last_bucket_ ? last_pos_ + 1 : kBucketSize;
+    size_t len = std::min(left, hi - first_pos_);
+    if (is_shared(bucket_num)) {
+      reclaim(bucket_num);
+    }
+    destroy_range(bucket_num, first_pos_, first_pos_ + len);
+    left -= len;
+    first_pos_ += len;
+    if (first_pos_ == kBucketSize) {
+      first_pos_ = 0;
+      ++first_bucket_;
+    }
+    drop_shared(bucket_num);
+  }
+  size_ -= count;
+}
+
+template <typename T, typename Allocator>
+template <typename OutputIt>
+OutputIt Deque<T, Allocator>::drain_back_into(OutputIt out, size_t count) {
+  size_t left = count;
+  size_t bucket_num = last_bucket_;
+  size_t hi = last_pos_ + 1;
+  while (left > 0) {
+    size_t lo = bucket_num == first_bucket_ ? first_pos_ : 0;
+    size_t len = std::min(left, hi - lo);
+    T* bucket = data_[bucket_num];
+    if (!is_shared(bucket_num)) {
+      out = std::move(std::make_reverse_iterator(bucket + hi),
+                      std::make_reverse_iterator(bucket + hi - len), out);
+    } else if constexpr (std::is_copy_constructible_v<T>) {
+      out = std::copy(std::make_reverse_iterator(bucket + hi),
+                      std::make_reverse_iterator(bucket + hi - len), out);
+    }
+    left -= len;
+    --bucket_num;
+    hi = kBucketSize;
+  }
+  pop_back_n(count);
+  return out;
+}
+
+template <typename T, typename Allocator>
+template <typename OutputIt>
+OutputIt Deque<T, Allocator>::drain_front_into(OutputIt out, size_t count) {
+  size_t left = count;
+  size_t bucket_num = first_bucket_;
+  size_t lo = first_pos_;
+  while (left > 0) {
+    size_t hi = bucket_num == last_bucket_ ? last_pos_ + 1 : kBucketSize;
+    size_t len = std::min(left, hi - lo);
+    T* bucket = data_[bucket_num];
+    if (!is_shared(bucket_num)) {
+      out = std::move(bucket + lo, bucket + lo + len, out);
+    } else if constexpr (std::is_copy_constructible_v<T>) {
+      out = std::copy(bucket + lo, bucket + lo + len, out);
+    }
+    left -= len;
+    ++bucket_num;
+    lo = 0;
+  }
+  pop_front_n(count);
+  return out;
 }
 
 template <typename T, typename Allocator>
@@ -927,6 +2003,7 @@ void Deque<T, Allocator>::insert(BaseIterator<IsConst> iter, const T& value) {
   }
   int ind = iter - begin();
   push_back(value);
+  reuse_back(front_seq_ + ind);
   for (int i = static_cast<int>(size_) - 1; i > ind; --i) {
     std::swap(operator[](i), operator[](i - 1));
   }
@@ -945,6 +2022,7 @@ void Deque<T, Allocator>::emplace(BaseIterator<IsConst> iter, T&& value) {
   }
   int ind = iter - begin();
   push_back(value);
+  reuse_back(front_seq_ + ind);
   for (int i = static_cast<int>(size_) - 1; i > ind; --i) {
     std::swap(operator[](i), operator[](i - 1));
   }
@@ -965,5 +2043,135 @@ void Deque<T, Allocator>::erase(BaseIterator<IsConst> iter) {
   for (int i = ind; i > 0; --i) {
     std::swap(operator[](i), operator[](i - 1));
   }
+  reuse_front(front_seq_ + ind);
   pop_front();
 }
+
+template <typename T, typename Allocator>
+template <typename Compare>
+void Deque<T, Allocator>::sort(Compare comp, Parallel par) {
+  sort_runs(comp, par, false);
+}
+
+template <typename T, typename Allocator>
+template <typename Compare>
+void Deque<T, Allocator>::stable_sort(Compare comp, Parallel par) {
+  sort_runs(comp, par, true);
+}
+
+template <typename T, typename Allocator>
+template <typename Compare>
+void Deque<T, Allocator>::sort_runs(Compare comp, Parallel par, bool stable) {
+  if (size_ < 2) {
+    return;
+  }
+  invalidate_handles();
+  T* buffer = alloc_traits::allocate(alloc_, size_);
+  size_t moved = 0;
+  try {
+    for_each_segment([&](T* ptr, size_t len) {
+      for (size_t i = 0; i < len; ++i, ++moved) {
+        alloc_traits::construct(alloc_, buffer + moved, std::move(ptr[i]));
+      }
+    });
+  } catch (...) {
+    for (size_t i = 0; i < moved; ++i) {
+      alloc_traits::destroy(alloc_, buffer + i);
+    }
+    alloc_traits::deallocate(alloc_, buffer, size_);
+    throw;
+  }
+
+  std::exception_ptr error;
+  try {
+    size_t runs = std::min(std::max<size_t>(par.threads, 1), size_);
+    std::vector<size_t> bounds(runs + 1);
+    for (size_t i = 0; i <= runs; ++i) {
+      bounds[i] = size_ * i / runs;
+    }
+    run_parallel(runs, runs, [&](size_t lo, size_t hi) {
+      for (size_t run = lo; run < hi; ++run) {
+        if (stable) {
+          std::stable_sort(buffer + bounds[run], buffer + bounds[run + 1],
+                           comp);
+        } else {
+          std::sort(buffer + bounds[run], buffer + bounds[run + 1], comp);
+        }
+      }
+    });
+    for (size_t width = 1; width < runs; width *= 2) {
+      size_t pairs = (runs + 2 * width - 1) / (2 * width);
+      run_parallel(par.threads, pairs, [&](size_t lo, size_t hi) {
+        for (size_t pair = lo; pair < hi; ++pair) {
+          size_t left = pair * 2 * width;
+          size_t mid = std::min(left + width, runs);
+          size_t right = std::min(left + 2 * width, runs);
+          if (mid < right) {
+            std::inplace_merge(buffer + bounds[left], buffer + bounds[mid],
+                               buffer + bounds[right], comp);
+          }
+        }
+      });
+    }
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  size_t pos = 0;
+  for_each_segment([&](T* ptr, size_t len) {
+    for (size_t i = 0; i < len; ++i, ++pos) {
+      ptr[i] = std::move(buffer[pos]);
+      alloc_traits::destroy(alloc_, buffer + pos);
+    }
+  });
+  alloc_traits::deallocate(alloc_, buffer, size_);
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::radix_sort()
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+{
+  using Key = std::make_unsigned_t<T>;
+  static constexpr Key kSignFlip =
+      std::is_signed_v<T> ? Key(1) << (sizeof(T) * 8 - 1) : 0;
+  if (size_ < 2) {
+    return;
+  }
+  invalidate_handles();
+  std::vector<Key> keys(size_);
+  std::vector<Key> scratch(size_);
+  size_t pos = 0;
+  for_each_segment([&](T* ptr, size_t len) {
+    for (size_t i = 0; i < len; ++i, ++pos) {
+      keys[pos] = static_cast<Key>(ptr[i]) ^ kSignFlip;
+    }
+  });
+  for (size_t shift = 0; shift < sizeof(T) * 8; shift += 8) {
+    size_t counts[256] = {};
+    for (Key key : keys) {
+      ++counts[(key >> shift) & 0xFF];
+    }
+    if (counts[(keys[0] >> shift) & 0xFF] == size_) {
+      continue;
+    }
+    size_t offset = 0;
+    for (size_t& count : counts) {
+      size_t next = offset + count;
+      count = offset;
+      offset = next;
+    }
+    for (Key key : keys) {
+      scratch[counts[(key >> shift) & 0xFF]++] = key;
+    }
+    keys.swap(scratch);
+  }
+  pos = 0;
+  for_each_segment([&](T* ptr, size_t len) {
+    for (size_t i = 0; i < len; ++i, ++pos) {
+      ptr[i] = static_cast<T>(keys[pos] ^ kSignFlip);
+    }
+  });
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+#include "deque.hpp"
+
+enum class TraceOp : uint8_t {
+  kPushBack,
+  kPushFront,
+  kPopBack,
+  kPopFront,
+  kInsert,
+  kErase,
+  kIndex,
+  kSize,
+};
+
+struct TraceEvent {
+  TraceOp op;
+  uint64_t arg;
+};
+
+class TraceWriter {
+ public:
+  static constexpr char kMagic[4] = {'D', 'Q', 'T', '1'};
+
+  TraceWriter(std::ostream& out) : out_(out) { out_.write(kMagic, 4); }
+
+  void record(TraceOp op, uint64_t arg = 0) {
+    out_.put(static_cast<char>(op));
+    do {
+      uint8_t byte = arg & 0x7F;
+      arg >>= 7;
+      out_.put(static_cast<char>(arg != 0 ? byte | 0x80 : byte));
+    } while (arg != 0);
+  }
+
+ private:
+  std::ostream& out_;
+};
+
+class TraceReader {
+ public:
+  TraceReader(std::istream& in) : in_(in) {
+    char magic[4] = {};
+    in_.read(magic, 4);
+    if (!in_ || !std::equal(magic, magic + 4, TraceWriter::kMagic)) {
+      throw std::runtime_error("Not a deque trace!");
+    }
+  }
+
+  bool next(TraceEvent& event) {
+    int op = in_.get();
+    if (op == std::istream::traits_type::eof()) {
+      return false;
+    }
+    if (op > static_cast<int>(TraceOp::kSize)) {
+      throw std::runtime_error("Invalid deque trace!");
+    }
+    event.op = static_cast<TraceOp>(op);
+    event.arg = 0;
+    for (int shift = 0;; shift += 7) {
+      int byte = in_.get();
+      if (byte == std::istream::traits_type::eof()) {
+        throw std::runtime_error("Truncated deque trace!");
+      }
+      uint64_t bits = static_cast<uint64_t>(byte & 0x7F);
+      if (shift >= 64 || (bits << shift) >> shift != bits) {
+        throw std::runtime_error("Invalid deque trace!");
+      }
+      event.arg |= bits << shift;
+      if ((byte & 0x80) == 0) {
+        return true;
+      }
+    }
+  }
+
+ private:
+  std::istream& in_;
+};
+
+template <typename T, typename Allocator = std::allocator<T>>
+class TracedDeque {
+ public:
+  using iterator = typename Deque<T, Allocator>::iterator;
+  using const_iterator = typename Deque<T, Allocator>::const_iterator;
+
+  TracedDeque(TraceWriter& writer, const Allocator& alloc = Allocator())
+      : writer_(writer), deque_(alloc) {}
+
+  [[nodiscard]] size_t size() const {
+    writer_.record(TraceOp::kSize, deque_.size());
+    return deque_.size();
+  }
+
+  [[nodiscard]] bool empty() const { return size() == 0; }
+
+  T& operator[](int ind) {
+    writer_.record(TraceOp::kIndex, ind);
+    return deque_[ind];
+  }
+
+  const T& operator[](int ind) const {
+    writer_.record(TraceOp::kIndex, ind);
+    return deque_[ind];
+  }
+
+  T& at(size_t ind) {
+    writer_.record(TraceOp::kIndex, ind);
+    return deque_.at(ind);
+  }
+
+  const T& at(size_t ind) const {
+    writer_.record(TraceOp::kIndex, ind);
+    return deque_.at(ind);
+  }
+
+  template <typename... Args>
+  void emplace_back(Args&&... args) {
+    writer_.record(TraceOp::kPushBack);
+    deque_.emplace_back(std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  void emplace_front(Args&&... args) {
+    writer_.record(TraceOp::kPushFront);
+    deque_.emplace_front(std::forward<Args>(args)...);
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  void push_front(const T& value) { emplace_front(value); }
+
+  void push_front(T&& value) { emplace_front(std::move(value)); }
+
+  void pop_back() {
+    writer_.record(TraceOp::kPopBack);
+    deque_.pop_back();
+  }
+
+  void pop_front() {
+    writer_.record(TraceOp::kPopFront);
+    deque_.pop_front();
+  }
+
+  iterator begin() { return deque_.begin(); }
+
+  iterator end() { return deque_.end(); }
+
+  const_iterator begin() const { return deque_.begin(); }
+
+  const_iterator end() const { return deque_.end(); }
+
+  void insert(iterator iter, const T& value) {
+    writer_.record(TraceOp::kInsert, iter - deque_.begin());
+    deque_.insert(iter, value);
+  }
+
+  void erase(iterator iter) {
+    writer_.record(TraceOp::kErase, iter - deque_.begin());
+    deque_.erase(iter);
+  }
+
+  [[nodiscard]] const Deque<T, Allocator>& deque() const { return deque_; }
+
+ private:
+  TraceWriter& writer_;
+  Deque<T, Allocator> deque_;
+};
@@ -0,0 +1,107 @@
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include "deque.hpp"
+
+static constexpr size_t kTestSize = 10000000;
+static constexpr size_t kBatches[] = {16, 256, 4096};
+
+template <typename F>
+double MeasureMs(F&& func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+template <typename T, typename Make>
+void Run(const std::string& name, Make&& make) {
+    for (size_t batch: kBatches) {
+        std::vector<T> out;
+        out.reserve(batch);
+        size_t sink = 0;
+
+        Deque<T> append_source;
+        for (size_t i = 0; i < kTestSize; ++i) {
+            append_source.push_back(make(i));
+        }
+        double append = MeasureMs([&]() {
+            while (!append_source.empty()) {
+                out.clear();
+                for (size_t i = 0; i < batch && !append_source.empty(); ++i) {
+                    out.push_back(std::move(append_source[0]));
+                    append_source.pop_front();
+                }
+                sink += out.size();
+            }
+        });
+
+        Deque<T> drain_source;
+        for (size_t i = 0; i < kTestSize; ++i) {
+            drain_source.push_back(make(i));
+        }
+        double drain = MeasureMs([&]() {
+            while (!drain_source.empty()) {
+                out.clear();
+                drain_source.drain_front_into(std::back_inserter(out),
+                                              std::min(batch, drain_source.size()));
+                sink += out.size();
+            }
+        });
+
+        std::deque<T> std_source;
+        for (size_t i = 0; i < kTestSize; ++i) {
+            std_source.push_back(make(i));
+        }
+        double std_append = MeasureMs([&]() {
+            while (!std_source.empty()) {
+                out.clear();
+                for (size_t i = 0; i < batch && !std_source.empty(); ++i) {
+                    out.push_back(std::move(std_source.front()));
+                    std_source.pop_front();
+                }
+                sink += out.size();
+            }
+        });
+
+        Deque<T> pop_source;
+        for (size_t i = 0; i < kTestSize; ++i) {
+            pop_source.push_back(make(i));
+        }
+        double pop = MeasureMs([&]() {
+            while (!pop_source.empty()) {
+                for (size_t i = 0; i < batch && !pop_source.empty(); ++i) {
+                    pop_source.pop_back();
+                }
+            }
+        });
+
+        Deque<T> pop_n_source;
+        for (size_t i = 0; i < kTestSize; ++i) {
+            pop_n_source.push_back(make(i));
+        }
+        double pop_n = MeasureMs([&]() {
+            while (!pop_n_source.empty()) {
+                pop_n_source.pop_back_n(std::min(batch, pop_n_source.size()));
+            }
+        });
+
+        std::cout << name << ", batch " << batch << ": pop_front + append " << append
+                  << " ms, drain_front_into " << drain << " ms, std::deque " << std_append
+                  << " ms; pop_back loop " << pop << " ms, pop_back_n " << pop_n
+                  << " ms (checksum " << sink << ")" << std::endl;
+    }
+}
+
+int main() {
+    Run<uint64_t>("uint64_t", [](size_t i) { return static_cast<uint64_t>(i); });
+    Run<std::string>("std::string",
+                     [](size_t i) { return std::to_string(i * 2654435761ULL); });
+
+    return 0;
+}
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+struct HugePageOptions {
+  size_t region_size = size_t(64) << 20;
+  bool use_hugetlb = false;
+  int numa_node = -1;
+};
+
+class HugePageArena {
+ public:
+  static const size_t kHugePageSize = size_t(2) << 20;
+  static const size_t kAlignment = alignof(std::max_align_t);
+
+  HugePageArena(HugePageOptions options = HugePageOptions());
+
+  HugePageArena(const HugePageArena& other) = delete;
+
+  HugePageArena& operator=(const HugePageArena& other) = delete;
+
+  ~HugePageArena();
+
+  static const std::shared_ptr<HugePageArena>& global();
+
+  void* allocate(size_t bytes);
+
+  void deallocate(void* ptr, size_t bytes);
+
+  [[nodiscard]] size_t mapped_bytes() const;
+
+  [[nodiscard]] bool hugetlb_used() const;
+
+  [[nodiscard]] bool numa_bound() const;
+
+ private:
+  struct Region {
+    void* addr;
+    size_t bytes;
+  };
+
+  Region map_region(size_t bytes);
+
+  static size_t round_up(size_t value, size_t step) {
+    return (value + step - 1) / step * step;
+  }
+
+  HugePageOptions options_;
+  mutable std::mutex mutex_;
+  std::vector<Region> regions_;
+  std::unordered_map<void*, size_t> large_;
+  std::unordered_map<size_t, std::vector<void*>> free_lists_;
+  char* cur_ = nullptr;
+  size_t left_ = 0;
+  size_t mapped_bytes_ = 0;
+  bool hugetlb_used_ = false;
+  bool numa_bound_ = false;
+};
+
+template <typename T>
+class HugePageAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  HugePageAllocator() : arena_(HugePageArena::global()) {}
+
+  HugePageAllocator(std::shared_ptr<HugePageArena> arena)
+      : arena_(std::move(arena)) {}
+
+  template <typename U>
+  HugePageAllocator(const HugePageAllocator<U>& other)
+      : arena_(other.arena()) {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(arena_->allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* ptr, size_t n) { arena_->deallocate(ptr, n * sizeof(T)); }
+
+  [[nodiscard]] const std::shared_ptr<HugePageArena>& arena() const {
+    return arena_;
+  }
+
+  template <typename U>
+  bool operator==(const HugePageAllocator<U>& other) const {
+    return arena_ == other.arena();
+  }
+
+  template <typename U>
+  bool operator!=(const HugePageAllocator<U>& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  std::shared_ptr<HugePageArena> arena_;
+};
+
+inline HugePageArena::HugePageArena(HugePageOptions options)
+    : options_(options) {
+  options_.region_size = round_up(options_.region_size, kHugePageSize);
+}
+
+inline HugePageArena::~HugePageArena() {
+  for (auto& region : regions_) {
+    munmap(region.addr, region.bytes);
+  }
+  for (auto& [addr, bytes] : large_) {
+    munmap(addr, bytes);
+  }
+}
+
+inline const std::shared_ptr<HugePageArena>& HugePageArena::global() {
+  static const std::shared_ptr<HugePageArena> arena =
+      std::make_shared<HugePageArena>();
+  return arena;
+}
+
+inline HugePageArena::Region HugePageArena::map_region(size_t bytes) {
+  bytes = round_up(bytes, kHugePageSize);
+  void* addr = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  if (options_.use_hugetlb) {
+    addr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (addr != MAP_FAILED) {
+      hugetlb_used_ = true;
+    }
+  }
+#endif
+  if (addr == MAP_FAILED) {
+    size_t padded = bytes + kHugePageSize;
+    void* raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    auto begin = reinterpret_cast<uintptr_t>(raw);
+    uintptr_t aligned = round_up(begin, kHugePageSize);
+    if (aligned > begin) {
+      munmap(raw, aligned - begin);
+    }
+    if (aligned + bytes < begin + padded) {
+      munmap(reinterpret_cast<void*>(aligned + bytes),
+             begin + padded - aligned - bytes);
+    }
+    addr = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+    madvise(addr, bytes, MADV_HUGEPAGE);
+#endif
+  }
+#ifdef SYS_mbind
+  if (options_.numa_node >= 0) {
+    static const int kMpolBind = 2;
+    const size_t bits = sizeof(unsigned long) * 8;
+    std::vector<unsigned long> mask(options_.numa_node / bits + 1, 0);
+    mask[options_.numa_node / bits] = 1UL << (options_.numa_node % bits);
+    numa_bound_ = syscall(SYS_mbind, addr, bytes, kMpolBind, mask.data(),
+                          mask.size() * bits, 0) == 0;
+  }
+#endif
+  mapped_bytes_ += bytes;
+  return {addr, bytes};
+}
+
+inline void* HugePageArena::allocate(size_t bytes) {
+  bytes = round_up(bytes == 0 ? 1 : bytes, kAlignment);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (bytes > options_.region_size / 2) {
+    Region region = map_region(bytes);
+    large_.emplace(region.addr, region.bytes);
+    return region.addr;
+  }
+  auto free_list = free_lists_.find(bytes);
+  if (free_list != free_lists_.end() && !free_list->second.empty()) {
+    void* ptr = free_list->second.back();
+    free_list->second.pop_back();
+    return ptr;
+  }
+  if (left_ < bytes) {
+    Region region = map_region(options_.region_size);
+    regions_.push_back(region);
+    cur_ = static_cast<char*>(region.addr);
+    left_ = region.bytes;
+  }
+  void* ptr = cur_;
+  cur_ += bytes;
+  left_ -= bytes;
+  return ptr;
+}
+
+inline void HugePageArena::deallocate(void* ptr, size_t bytes) {
+  bytes = round_up(bytes == 0 ? 1 : bytes, kAlignment);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto large = large_.find(ptr);
+  if (large != large_.end()) {
+    munmap(large->first, large->second);
+    mapped_bytes_ -= large->second;
+    large_.erase(large);
+    return;
+  }
+  free_lists_[bytes].push_back(ptr);
+}
+
+inline size_t HugePageArena::mapped_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return mapped_bytes_;
+}
+
+inline bool HugePageArena::hugetlb_used() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hugetlb_used_;
+}
+
+inline bool HugePageArena::numa_bound() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return numa_bound_;
+}
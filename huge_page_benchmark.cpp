@@ -0,0 +1,72 @@
+#include <random>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include "deque.hpp"
+#include "huge_page_allocator.hpp"
+
+static constexpr size_t kTestSize = 32 << 20;
+static constexpr size_t kLookups = 10000000;
+
+template <typename F>
+double MeasureMs(F&& func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+template <typename Container>
+void Run(const std::string& name, Container& d, const std::vector<uint32_t>& lookups) {
+    double fill = MeasureMs([&d]() {
+        for (size_t i = 0; i < kTestSize; ++i) {
+            d.push_back(i);
+        }
+    });
+    uint64_t sink = 0;
+    double lookup = MeasureMs([&]() {
+        for (const auto& index: lookups) {
+            sink += std::as_const(d)[static_cast<int>(index)];
+        }
+    });
+    double drain = MeasureMs([&d]() {
+        while (!d.empty()) {
+            d.pop_front();
+        }
+    });
+    std::cout << name << ": push_back " << fill << " ms, random lookups " << lookup
+              << " ms, pop_front " << drain << " ms (checksum " << sink << ")" << std::endl;
+}
+
+int main() {
+    std::mt19937 mersenne_engine{42};
+    std::vector<uint32_t> lookups(kLookups);
+    for (auto& lookup: lookups) {
+        lookup = static_cast<uint32_t>(mersenne_engine() % kTestSize);
+    }
+
+    {
+        Deque<uint64_t> d;
+        Run("std::allocator", d, lookups);
+    }
+    {
+        auto arena = std::make_shared<HugePageArena>();
+        Deque<uint64_t, HugePageAllocator<uint64_t>> d{HugePageAllocator<uint64_t>(arena)};
+        Run("HugePageAllocator, transparent huge pages", d, lookups);
+        std::cout << "  mapped " << (arena->mapped_bytes() >> 20) << " MiB" << std::endl;
+    }
+    {
+        HugePageOptions options;
+        options.use_hugetlb = true;
+        auto arena = std::make_shared<HugePageArena>(options);
+        Deque<uint64_t, HugePageAllocator<uint64_t>> d{HugePageAllocator<uint64_t>(arena)};
+        Run("HugePageAllocator, MAP_HUGETLB", d, lookups);
+        std::cout << "  hugetlb used: " << std::boolalpha << arena->hugetlb_used() << std::endl;
+    }
+
+    return 0;
+}
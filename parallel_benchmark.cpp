@@ -0,0 +1,41 @@
+#include <string>
+#include <thread>
+#include <chrono>
+#include <iostream>
+#include "deque.hpp"
+
+template <typename F>
+double MeasureMs(F&& func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+using StringDeque = Deque<std::string>;
+
+static constexpr size_t kTestSize = 2000000;
+static constexpr size_t kMaxThreads = 32;
+
+int main() {
+    std::string value(40, 'x');
+    StringDeque source(kTestSize, value);
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+    for (size_t threads = 1; threads <= kMaxThreads; threads *= 2) {
+        StringDeque::Parallel par{threads};
+        StringDeque* filled = nullptr;
+        double fill = MeasureMs([&]() { filled = new StringDeque(kTestSize, value, par); });
+        double clear = MeasureMs([&]() { filled->clear(par); });
+        delete filled;
+
+        StringDeque* copied = nullptr;
+        double copy = MeasureMs([&]() { copied = new StringDeque(source, par); });
+        delete copied;
+
+        std::cout << threads << " threads: fill " << fill << " ms, copy " << copy
+                  << " ms, clear " << clear << " ms" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,1302 @@
+#include <random>
+#include <algorithm>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <string>
+#include <iostream>
+#include "async_deque.hpp"
+#include "compressed_deque.hpp"
+#include "deque.hpp"
+#include "deque_trace.hpp"
+#include "huge_page_allocator.hpp"
+#include "ring_deque.hpp"
+#include "soa_deque.hpp"
+#include "sorted_deque.hpp"
+#include "tiered_deque.hpp"
+#include "window_aggregator.hpp"
+
+static constexpr unsigned kSeed = 20240607;
+static constexpr size_t kRounds = 200;
+
+template <typename Actual, typename Expected>
+bool SameElements(const Actual& actual, const Expected& expected) {
+    if (actual.size() != expected.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (!(actual[static_cast<int>(i)] == expected[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Report(const std::string& name, bool ok) {
+    if (!ok) {
+        std::cerr << name << ": mismatch against the reference container" << std::endl;
+    }
+    return ok;
+}
+
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    explicit CountingAllocator(size_t* count) : count(count) {}
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& other) : count(other.count) {}
+
+    T* allocate(size_t n) {
+        ++*count;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* ptr, size_t n) { std::allocator<T>().deallocate(ptr, n); }
+
+    bool operator==(const CountingAllocator& other) const { return count == other.count; }
+
+    size_t* count;
+};
+
+bool TestSort(std::mt19937& mersenne_engine) {
+    std::uniform_int_distribution<int> value_dist{-1000, 1000};
+    for (size_t round = 0; round < kRounds; ++round) {
+        size_t size = mersenne_engine() % 2000;
+        size_t threads = 1 + mersenne_engine() % 8;
+
+        Deque<int> d;
+        std::vector<int> expected;
+        for (size_t i = 0; i < size; ++i) {
+            int value = value_dist(mersenne_engine);
+            if (mersenne_engine() % 2 == 0) {
+                d.push_back(value);
+                expected.push_back(value);
+            } else {
+                d.push_front(value);
+                expected.insert(expected.begin(), value);
+            }
+        }
+
+        Deque<int> radix = d;
+        std::vector<std::pair<int, size_t>> keyed;
+        Deque<std::pair<int, size_t>> stable;
+        for (size_t i = 0; i < size; ++i) {
+            keyed.emplace_back(expected[i] / 16, i);
+            stable.push_back(keyed.back());
+        }
+
+        std::sort(expected.begin(), expected.end());
+        d.sort(std::less<int>(), Deque<int>::Parallel{threads});
+        radix.radix_sort();
+
+        auto by_key = [](const std::pair<int, size_t>& lhs,
+                         const std::pair<int, size_t>& rhs) {
+            return lhs.first < rhs.first;
+        };
+        std::stable_sort(keyed.begin(), keyed.end(), by_key);
+        stable.stable_sort(by_key, Deque<std::pair<int, size_t>>::Parallel{threads});
+
+        if (!Report("sort", SameElements(d, expected)) ||
+            !Report("radix_sort", SameElements(radix, expected)) ||
+            !Report("stable_sort", SameElements(stable, keyed))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TestWindows(std::mt19937& mersenne_engine) {
+    std::uniform_int_distribution<long long> value_dist{-1000, 1000};
+    for (size_t round = 0; round < kRounds; ++round) {
+        size_t window = mersenne_engine() % 4 == 0 ? 0 : 1 + mersenne_engine() % 64;
+        WindowAggregator<long long, std::plus<long long>> sum(window);
+        MonotonicWindow<long long> minimum(window);
+        MonotonicWindow<long long, std::greater<long long>> maximum(window);
+        std::deque<long long> expected;
+
+        for (size_t step = 0; step < 500; ++step) {
+            if (expected.empty() || mersenne_engine() % 3 != 0) {
+                long long value = value_dist(mersenne_engine);
+                if (window != 0 && expected.size() == window) {
+                    expected.pop_front();
+                }
+                expected.push_back(value);
+                sum.push(value);
+                minimum.push(value);
+                maximum.push(value);
+            } else {
+                expected.pop_front();
+                sum.evict();
+                minimum.evict();
+                maximum.evict();
+            }
+            if (sum.size() != expected.size() || minimum.size() != expected.size()) {
+                return Report("window size", false);
+            }
+            if (expected.empty()) {
+                continue;
+            }
+            long long expected_sum = std::accumulate(expected.begin(), expected.end(), 0LL);
+            long long expected_min = *std::min_element(expected.begin(), expected.end());
+            long long expected_max = *std::max_element(expected.begin(), expected.end());
+            if (!Report("WindowAggregator", sum.query() == expected_sum) ||
+                !Report("MonotonicWindow min", minimum.query() == expected_min) ||
+                !Report("MonotonicWindow max", maximum.query() == expected_max)) {
+                return false;
+            }
+        }
+    }
+
+    Deque<long long> sliding;
+    for (long long i = 0; i < 1000000; ++i) {
+        sliding.push_back(i);
+        if (sliding.size() > 16) {
+            sliding.pop_front();
+        }
+    }
+    size_t slots = sliding.capacity_front() + sliding.size() + sliding.capacity_back();
+    return Report("sliding Deque capacity", slots <= 64 * Deque<long long>::kBucketSize);
+}
+
+bool TestSoA(std::mt19937& mersenne_engine) {
+    using Row = std::tuple<int, std::string, double>;
+    for (size_t round = 0; round < kRounds; ++round) {
+        SoADeque<int, std::string, double> d;
+        std::deque<Row> expected;
+        size_t steps = round % 10 == 0 ? 4000 : 300;
+        for (size_t step = 0; step < steps; ++step) {
+            int value = static_cast<int>(mersenne_engine() % 1000);
+            Row row{value, std::to_string(value), value / 4.0};
+            switch (mersenne_engine() % 6) {
+                case 0:
+                case 1:
+                    d.push_back(row);
+                    expected.push_back(row);
+                    break;
+                case 2:
+                    d.push_front(row);
+                    expected.push_front(row);
+                    break;
+                case 3:
+                    if (!expected.empty()) {
+                        d.pop_back();
+                        expected.pop_back();
+                    }
+                    break;
+                case 4:
+                    if (mersenne_engine() % 8 == 0) {
+                        SoADeque<int, std::string, double> copy(d);
+                        if (mersenne_engine() % 2 == 0) {
+                            d = copy;
+                        } else {
+                            d = std::move(copy);
+                        }
+                    }
+                    break;
+                default:
+                    if (!expected.empty()) {
+                        d.pop_front();
+                        expected.pop_front();
+                    }
+                    break;
+            }
+        }
+        if (!Report("SoADeque size", d.size() == expected.size())) {
+            return false;
+        }
+        for (size_t i = 0; i < expected.size(); ++i) {
+            if (!Report("SoADeque row", Row(d[static_cast<int>(i)]) == expected[i])) {
+                return false;
+            }
+        }
+        std::vector<std::string> column;
+        d.for_each_segment<1>([&column](const std::string* ptr, size_t len) {
+            column.insert(column.end(), ptr, ptr + len);
+        });
+        if (!Report("SoADeque column size", column.size() == expected.size())) {
+            return false;
+        }
+        for (size_t i = 0; i < expected.size(); ++i) {
+            if (!Report("SoADeque column", column[i] == std::get<1>(expected[i]))) {
+                return false;
+            }
+        }
+        try {
+            d.at(expected.size());
+            return Report("SoADeque at", false);
+        } catch (const std::out_of_range&) {
+        }
+    }
+    return true;
+}
+
+bool TestCompressed(std::mt19937& mersenne_engine) {
+    for (size_t round = 0; round < kRounds; ++round) {
+        int64_t spread = int64_t(1) << (mersenne_engine() % 63);
+        std::uniform_int_distribution<int64_t> value_dist{-spread, spread};
+        CompressedDeque<int64_t> d;
+        std::deque<int64_t> expected;
+        for (size_t step = 0; step < 2000; ++step) {
+            int64_t value = value_dist(mersenne_engine);
+            if (mersenne_engine() % 50 == 0) {
+                value = mersenne_engine() % 2 == 0 ? std::numeric_limits<int64_t>::min()
+                                                   : std::numeric_limits<int64_t>::max();
+            }
+            switch (mersenne_engine() % 6) {
+                case 0:
+                case 1:
+                    d.push_back(value);
+                    expected.push_back(value);
+                    break;
+                case 2:
+                case 3:
+                    d.push_front(value);
+                    expected.push_front(value);
+                    break;
+                case 4:
+                    if (!expected.empty()) {
+                        d.pop_back();
+                        expected.pop_back();
+                    }
+                    break;
+                default:
+                    if (!expected.empty()) {
+                        d.pop_front();
+                        expected.pop_front();
+                    }
+                    break;
+            }
+        }
+        if (!Report("CompressedDeque", SameElements(d, expected))) {
+            return false;
+        }
+        std::vector<int64_t> scanned;
+        d.for_each([&scanned](int64_t value) { scanned.push_back(value); });
+        if (!Report("CompressedDeque for_each",
+                    std::equal(scanned.begin(), scanned.end(), expected.begin(),
+                               expected.end()))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct Task {
+    struct promise_type {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+Task Produce(AsyncDeque<int>& queue, int producer, int count) {
+    for (int i = 0; i < count; ++i) {
+        co_await queue.push_back(producer * 100000 + i);
+    }
+}
+
+Task Consume(AsyncDeque<int>& queue, int count, std::vector<int>& out) {
+    for (int i = 0; i < count; ++i) {
+        out.push_back(co_await queue.pop_front());
+    }
+}
+
+bool TestAsync(std::mt19937& mersenne_engine) {
+    for (size_t round = 0; round < kRounds; ++round) {
+        std::vector<std::coroutine_handle<>> ready;
+        size_t capacity = mersenne_engine() % 4;
+        AsyncDeque<int> queue(capacity,
+                              [&ready](std::coroutine_handle<> handle) { ready.push_back(handle); });
+
+        int producers = 1 + static_cast<int>(mersenne_engine() % 3);
+        int consumers = 1 + static_cast<int>(mersenne_engine() % 3);
+        int per_producer = 1 + static_cast<int>(mersenne_engine() % 50);
+        int total = producers * per_producer;
+        std::vector<std::vector<int>> received(consumers);
+        int producer = 0;
+        int consumer = 0;
+        int assigned = 0;
+        while (producer < producers || consumer < consumers || !ready.empty()) {
+            size_t choice = mersenne_engine() % 3;
+            if (choice == 0 && producer < producers) {
+                Produce(queue, producer++, per_producer);
+            } else if (choice == 1 && consumer < consumers) {
+                int count = consumer + 1 == consumers ? total - assigned : total / consumers;
+                assigned += count;
+                Consume(queue, count, received[consumer++]);
+            } else if (!ready.empty()) {
+                size_t pick = mersenne_engine() % ready.size();
+                std::coroutine_handle<> handle = ready[pick];
+                ready.erase(ready.begin() + static_cast<long>(pick));
+                handle.resume();
+            }
+        }
+
+        std::vector<int> all;
+        for (const auto& values: received) {
+            std::vector<int> last(producers, -1);
+            for (int value: values) {
+                if (!Report("AsyncDeque order", value % 100000 > last[value / 100000])) {
+                    return false;
+                }
+                last[value / 100000] = value % 100000;
+            }
+            all.insert(all.end(), values.begin(), values.end());
+        }
+        std::sort(all.begin(), all.end());
+        std::vector<int> expected;
+        for (int p = 0; p < producers; ++p) {
+            for (int i = 0; i < per_producer; ++i) {
+                expected.push_back(p * 100000 + i);
+            }
+        }
+        if (!Report("AsyncDeque delivery", all == expected && queue.empty())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TestHugePages(std::mt19937& mersenne_engine) {
+    using Allocator = HugePageAllocator<long>;
+    HugePageOptions options;
+    options.region_size = size_t(4) << 20;
+    auto arena = std::make_shared<HugePageArena>(options);
+    Allocator alloc(arena);
+    for (size_t round = 0; round < kRounds; ++round) {
+        Deque<long, Allocator> d(alloc);
+        std::deque<long> expected;
+        for (size_t step = 0; step < 1000; ++step) {
+            long value = static_cast<long>(mersenne_engine() % 100000);
+            switch (mersenne_engine() % 8) {
+                case 0:
+                case 1:
+                    d.push_back(value);
+                    expected.push_back(value);
+                    break;
+                case 2:
+                case 3:
+                    d.push_front(value);
+                    expected.push_front(value);
+                    break;
+                case 4:
+                    if (!expected.empty()) {
+                        d.pop_back();
+                        expected.pop_back();
+                    }
+                    break;
+                case 5:
+                    if (!expected.empty()) {
+                        d.pop_front();
+                        expected.pop_front();
+                    }
+                    break;
+                case 6:
+                    if (!expected.empty()) {
+                        size_t pos = mersenne_engine() % expected.size();
+                        d.insert(d.begin() + static_cast<int>(pos), value);
+                        expected.insert(expected.begin() + static_cast<long>(pos), value);
+                    }
+                    break;
+                default:
+                    if (!expected.empty()) {
+                        size_t pos = mersenne_engine() % expected.size();
+                        d.erase(d.begin() + static_cast<int>(pos));
+                        expected.erase(expected.begin() + static_cast<long>(pos));
+                    }
+                    break;
+            }
+        }
+        Deque<long, Allocator> copy = d;
+        Deque<long, Allocator> moved(std::move(d));
+        if (!Report("HugePageAllocator deque", SameElements(moved, expected)) ||
+            !Report("HugePageAllocator copy", SameElements(copy, expected)) ||
+            !Report("HugePageAllocator arena",
+                    moved.get_allocator() == alloc && copy.get_allocator() == alloc)) {
+            return false;
+        }
+        moved.push_back(0);
+        expected.push_back(0);
+        if (!Report("HugePageAllocator moved-to deque", SameElements(moved, expected))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TestTiered(std::mt19937& mersenne_engine) {
+    for (size_t round = 0; round < kRounds; ++round) {
+        TieredDeque<long, 8> d;
+        std::deque<long> expected;
+        for (size_t step = 0; step < 1500; ++step) {
+            long value = static_cast<long>(step);
+            switch (mersenne_engine() % 8) {
+                case 0:
+                    d.push_back(value);
+                    expected.push_back(value);
+                    break;
+                case 1:
+                    d.push_front(value);
+                    expected.push_front(value);
+                    break;
+                case 2:
+                    if (!expected.empty()) {
+                        d.pop_back();
+                        expected.pop_back();
+                    }
+                    break;
+                case 3:
+                    if (!expected.empty()) {
+                        d.pop_front();
+                        expected.pop_front();
+                    }
+                    break;
+                case 4:
+                case 5:
+                case 6: {
+                    size_t pos = mersenne_engine() % (expected.size() + 1);
+                    d.insert(pos, value);
+                    expected.insert(expected.begin() + static_cast<long>(pos), value);
+                    break;
+                }
+                default:
+                    if (!expected.empty()) {
+                        size_t pos = mersenne_engine() % expected.size();
+                        d.erase(pos);
+                        expected.erase(expected.begin() + static_cast<long>(pos));
+                    }
+                    break;
+            }
+            if (step % 100 == 0 && !Report("TieredDeque", SameElements(d, expected))) {
+                return false;
+            }
+        }
+        TieredDeque<long, 8> copy = d;
+        std::vector<long> scanned;
+        copy.for_each([&scanned](const long& value) { scanned.push_back(value); });
+        if (!Report("TieredDeque", SameElements(d, expected)) ||
+            !Report("TieredDeque for_each",
+                    std::equal(scanned.begin(), scanned.end(), expected.begin(),
+                               expected.end()))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TestParallel(std::mt19937& mersenne_engine) {
+    using StringDeque = Deque<std::string>;
+    for (size_t round = 0; round < kRounds / 4; ++round) {
+        size_t size = mersenne_engine() % 3000;
+        StringDeque::Parallel par{1 + mersenne_engine() % 8};
+        std::string value = std::to_string(mersenne_engine());
+
+        StringDeque filled(size, value, par);
+        std::vector<std::string> expected(size, value);
+        if (!Report("parallel fill", SameElements(filled, expected))) {
+            return false;
+        }
+
+        size_t pushes = mersenne_engine() % 100;
+        for (size_t i = 0; i < pushes; ++i) {
+            std::string pushed = std::to_string(i);
+            if (i % 2 == 0) {
+                filled.push_back(pushed);
+                expected.push_back(pushed);
+            } else {
+                filled.push_front(pushed);
+                expected.insert(expected.begin(), pushed);
+            }
+        }
+        StringDeque copy(filled, par);
+        StringDeque assigned(mersenne_engine() % 50, std::string("old"), par);
+        assigned.assign(filled, par);
+        if (!Report("parallel copy", SameElements(copy, expected)) ||
+            !Report("parallel assign", SameElements(assigned, expected))) {
+            return false;
+        }
+
+        copy.clear(par);
+        copy.push_back(value);
+        if (!Report("parallel clear", copy.size() == 1 && copy[0] == value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TestHandles(std::mt19937& mersenne_engine) {
+    using Handle = Deque<std::string>::Handle;
+    struct Taken {
+        Handle handle;
+        std::string value;
+        long long seq;
+        long long token;
+    };
+    for (size_t round = 0; round < kRounds; ++round) {
+        Deque<std::string> d;
+        std::deque<std::string> expected;
+        std::deque<long long> tokens;
+        long long front = 0;
+        long long next_token = 0;
+        auto refresh = [&](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) {
+                tokens[i] = next_token++;
+            }
+        };
+        std::vector<Taken> handles;
+        for (size_t step = 0; step < 400; ++step) {
+            std::string value = std::to_string(round) + ":" + std::to_string(step);
+            switch (mersenne_engine() % 12) {
+                case 0:
+                case 1:
+                    d.push_back(value);
+                    expected.push_back(value);
+                    tokens.push_back(next_token++);
+                    break;
+                case 2:
+                case 3:
+                    d.push_front(value);
+                    expected.push_front(value);
+                    tokens.push_front(next_token++);
+                    --front;
+                    break;
+                case 4:
+                    if (!expected.empty()) {
+                        d.pop_back();
+                        expected.pop_back();
+                        tokens.pop_back();
+                    }
+                    break;
+                case 5:
+                    if (!expected.empty()) {
+                        d.pop_front();
+                        expected.pop_front();
+                        tokens.pop_front();
+                        ++front;
+                    }
+                    break;
+                case 6:
+                    if (expected.size() > 2) {
+                        size_t pos = 1 + mersenne_engine() % (expected.size() - 2);
+                        if (mersenne_engine() % 2 == 0) {
+                            d.insert(d.begin() + static_cast<int>(pos), value);
+                            expected.insert(expected.begin() + static_cast<long>(pos), value);
+                            tokens.insert(tokens.begin() + static_cast<long>(pos), 0);
+                            refresh(pos, tokens.size());
+                        } else {
+                            d.erase(d.begin() + static_cast<int>(pos));
+                            expected.erase(expected.begin() + static_cast<long>(pos));
+                            tokens.erase(tokens.begin() + static_cast<long>(pos));
+                            ++front;
+                            refresh(0, pos);
+                        }
+                    }
+                    break;
+                case 7:
+                    if (mersenne_engine() % 4 == 0) {
+                        d.linearize();
+                    }
+                    break;
+                case 8:
+                    if (mersenne_engine() % 4 != 0) {
+                        break;
+                    }
+                    if (mersenne_engine() % 2 == 0) {
+                        d.sort();
+                        std::sort(expected.begin(), expected.end());
+                        if (expected.size() >= 2) {
+                            refresh(0, tokens.size());
+                        }
+                    } else {
+                        Deque<std::string> copy(d);
+                        d = copy;
+                        front += static_cast<long long>(expected.size());
+                        refresh(0, tokens.size());
+                    }
+                    break;
+                default:
+                    if (!expected.empty()) {
+                        size_t pos = mersenne_engine() % expected.size();
+                        long long seq = front + static_cast<long long>(pos);
+                        handles.push_back({d.get_handle(pos), expected[pos], seq, tokens[pos]});
+                    }
+                    break;
+            }
+            for (const auto& taken: handles) {
+                long long index = taken.seq - front;
+                bool alive = index >= 0 && index < static_cast<long long>(tokens.size()) &&
+                             tokens[static_cast<size_t>(index)] == taken.token;
+                if (!Report("handle liveness", d.is_alive(taken.handle) == alive)) {
+                    return false;
+                }
+                if (!alive) {
+                    continue;
+                }
+                if (!Report("handle", d.index_of(taken.handle) == static_cast<size_t>(index) &&
+                                          *taken.handle == taken.value &&
+                                          taken.handle->size() == taken.value.size())) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    Deque<int> d;
+    for (int i = 0; i < 4; ++i) {
+        d.push_back(i);
+    }
+    auto kept = d.get_handle(2);
+    auto popped = d.get_handle(3);
+    d.pop_back();
+    d.push_back(30);
+    bool ok = Report("handle below back reuse", d.is_alive(kept)) &&
+              Report("popped handle", !d.is_alive(popped));
+    d.pop_front();
+    d.push_front(-1);
+    ok = Report("handle above front reuse", d.is_alive(kept)) && ok;
+    d.sort();
+    auto sorted = d.get_handle(1);
+    d.pop_back();
+    d.push_back(40);
+    ok = Report("handle after sort", d.is_alive(sorted) && !d.is_alive(kept)) && ok;
+    return ok;
+}
+
+struct Tracked {
+    static long live;
+
+    long value;
+
+    Tracked(long v) : value(v) { ++live; }
+
+    Tracked(const Tracked& other) : value(other.value) { ++live; }
+
+    Tracked& operator=(const Tracked& other) = default;
+
+    ~Tracked() { --live; }
+
+    bool operator==(const Tracked& other) const { return value == other.value; }
+};
+
+long Tracked::live = 0;
+
+bool TestSnapshots(std::mt19937& mersenne_engine) {
+    for (size_t round = 0; round < kRounds; ++round) {
+        {
+            Deque<Tracked> d;
+            std::deque<long> expected;
+            std::vector<std::pair<Deque<Tracked>::Snapshot, std::vector<long>>> snapshots;
+            for (size_t step = 0; step < 400; ++step) {
+                long value = static_cast<long>(step);
+                switch (mersenne_engine() % 12) {
+                    case 0:
+                    case 1:
+                        d.push_back(Tracked(value));
+                        expected.push_back(value);
+                        break;
+                    case 2:
+                        d.push_front(Tracked(value));
+                        expected.push_front(value);
+                        break;
+                    case 3:
+                        if (!expected.empty()) {
+                            d.pop_back();
+                            expected.pop_back();
+                        }
+                        break;
+                    case 4:
+                        if (!expected.empty()) {
+                            d.pop_front();
+                            expected.pop_front();
+                        }
+                        break;
+                    case 5: {
+                        size_t count = mersenne_engine() % (expected.size() + 1);
+                        if (mersenne_engine() % 2 == 0) {
+                            d.pop_front_n(count);
+                            expected.erase(expected.begin(),
+                                           expected.begin() + static_cast<long>(count));
+                        } else {
+                            d.pop_back_n(count);
+                            expected.erase(expected.end() - static_cast<long>(count),
+                                           expected.end());
+                        }
+                        break;
+                    }
+                    case 6:
+                        if (!expected.empty()) {
+                            size_t pos = mersenne_engine() % expected.size();
+                            d[static_cast<int>(pos)].value = -value;
+                            expected[pos] = -value;
+                        }
+                        break;
+                    case 7:
+                        if (!expected.empty()) {
+                            size_t pos = mersenne_engine() % expected.size();
+                            auto iter = d.begin() + static_cast<int>(pos);
+                            iter->value = value * 2;
+                            expected[pos] = value * 2;
+                        }
+                        break;
+                    case 8:
+                    case 9:
+                        snapshots.emplace_back(d.snapshot(),
+                                               std::vector<long>(expected.begin(), expected.end()));
+                        break;
+                    default:
+                        if (!snapshots.empty()) {
+                            snapshots.erase(snapshots.begin() +
+                                            static_cast<long>(mersenne_engine() % snapshots.size()));
+                        }
+                        break;
+                }
+                for (const auto& [snapshot, values]: snapshots) {
+                    if (snapshot.size() != values.size()) {
+                        return Report("snapshot size", false);
+                    }
+                    for (size_t i = 0; i < values.size(); ++i) {
+                        if (!Report("snapshot", snapshot[i].value == values[i])) {
+                            return false;
+                        }
+                    }
+                }
+            }
+            for (size_t i = 0; i < expected.size(); ++i) {
+                if (!Report("snapshot writer", d[static_cast<int>(i)].value == expected[i])) {
+                    return false;
+                }
+            }
+
+            snapshots.clear();
+            if (expected.size() >= 2) {
+                d.pop_front();
+                d.pop_back();
+                expected.pop_front();
+                expected.pop_back();
+            }
+            if (!Report("popped elements destroyed",
+                        Tracked::live == static_cast<long>(expected.size()))) {
+                return false;
+            }
+
+            auto snapshot = d.snapshot();
+            long copies_before = Tracked::live;
+            long sum = 0;
+            for (auto iter = d.begin(); iter != d.end(); ++iter) {
+                sum += std::as_const(d)[static_cast<int>(iter - d.begin())].value;
+            }
+            long expected_sum = std::accumulate(expected.begin(), expected.end(), 0L);
+            if (!Report("iteration copies", Tracked::live == copies_before) ||
+                !Report("iteration", sum == expected_sum)) {
+                return false;
+            }
+        }
+        if (!Report("snapshot leak", Tracked::live == 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TestLinearize(std::mt19937& mersenne_engine) {
+    static constexpr size_t kBucket = Deque<int>::kBucketSize;
+    for (size_t round = 0; round < kRounds; ++round) {
+        Deque<int> d;
+        std::deque<int> expected;
+        std::vector<Deque<int>::Snapshot> snapshots;
+        for (size_t step = 0; step < 300; ++step) {
+            int value = static_cast<int>(mersenne_engine() % 1000);
+            switch (mersenne_engine() % 10) {
+                case 0:
+                case 1:
+                    d.push_back(value);
+                    expected.push_back(value);
+                    break;
+                case 2:
+                case 3:
+                    d.push_front(value);
+                    expected.push_front(value);
+                    break;
+                case 4:
+                    if (!expected.empty()) {
+                        d.pop_back();
+                        expected.pop_back();
+                    }
+                    break;
+                case 5:
+                    if (!expected.empty()) {
+                        d.pop_front();
+                        expected.pop_front();
+                    }
+                    break;
+                case 6:
+                    if (snapshots.size() < 3) {
+                        snapshots.push_back(d.snapshot());
+                    } else {
+                        snapshots.clear();
+                    }
+                    break;
+                case 7: {
+                    auto span = d.try_contiguous();
+                    if (span && !Report("try_contiguous", SameElements(*span, expected))) {
+                        return false;
+                    }
+                    break;
+                }
+                default: {
+                    bool rebuilt = !d.try_contiguous().has_value();
+                    auto span = d.linearize();
+                    size_t slots = d.capacity_front() + d.size() + d.capacity_back();
+                    size_t live_buckets = expected.size() / kBucket + 2;
+                    if (!Report("linearize", SameElements(span, expected)) ||
+                        !Report("linearize contiguous", d.try_contiguous().has_value()) ||
+                        !Report("linearize capacity",
+                                !rebuilt || slots <= 2 * live_buckets * kBucket)) {
+                        return false;
+                    }
+                    break;
+                }
+            }
+            if (!Report("linearize writer", SameElements(d, expected))) {
+                return false;
+            }
+        }
+    }
+
+    Deque<int> creeping;
+    for (int i = 0; i < 100000; ++i) {
+        creeping.push_back(i);
+        if (creeping.size() > 10) {
+            creeping.pop_front();
+        }
+    }
+    creeping.push_front(-1);
+    auto span = creeping.linearize();
+    size_t slots = creeping.capacity_front() + creeping.size() + creeping.capacity_back();
+    return Report("linearize after creep", span.size() == 11 && span.front() == -1 &&
+                                               span.back() == 99999 && slots <= 8 * kBucket);
+}
+
+bool TestTrace(std::mt19937& mersenne_engine) {
+    for (size_t round = 0; round < kRounds; ++round) {
+        std::stringstream stream;
+        std::vector<TraceEvent> expected;
+        std::deque<int> reference;
+        {
+            TraceWriter writer(stream);
+            TracedDeque<int> d(writer);
+            for (int step = 0; step < 200; ++step) {
+                size_t size = reference.size();
+                switch (mersenne_engine() % 8) {
+                    case 0:
+                        d.push_back(step);
+                        reference.push_back(step);
+                        expected.push_back({TraceOp::kPushBack, 0});
+                        break;
+                    case 1:
+                        d.push_front(step);
+                        reference.push_front(step);
+                        expected.push_back({TraceOp::kPushFront, 0});
+                        break;
+                    case 2:
+                        if (size != 0) {
+                            d.pop_back();
+                            reference.pop_back();
+                            expected.push_back({TraceOp::kPopBack, 0});
+                        }
+                        break;
+                    case 3:
+                        if (size != 0) {
+                            d.pop_front();
+                            reference.pop_front();
+                            expected.push_back({TraceOp::kPopFront, 0});
+                        }
+                        break;
+                    case 4:
+                        if (size != 0) {
+                            size_t pos = mersenne_engine() % size;
+                            d.insert(d.begin() + static_cast<int>(pos), step);
+                            reference.insert(reference.begin() + static_cast<long>(pos), step);
+                            expected.push_back({TraceOp::kInsert, pos});
+                        }
+                        break;
+                    case 5:
+                        if (size != 0) {
+                            size_t pos = mersenne_engine() % size;
+                            d.erase(d.begin() + static_cast<int>(pos));
+                            reference.erase(reference.begin() + static_cast<long>(pos));
+                            expected.push_back({TraceOp::kErase, pos});
+                        }
+                        break;
+                    case 6:
+                        if (size != 0) {
+                            size_t pos = mersenne_engine() % size;
+                            if (!Report("traced index", d[static_cast<int>(pos)] == reference[pos])) {
+                                return false;
+                            }
+                            expected.push_back({TraceOp::kIndex, pos});
+                        }
+                        break;
+                    default:
+                        static_cast<void>(d.size());
+                        expected.push_back({TraceOp::kSize, size});
+                        break;
+                }
+            }
+            if (!Report("traced deque", SameElements(d.deque(), reference))) {
+                return false;
+            }
+        }
+
+        std::string bytes = stream.str();
+        std::stringstream in(bytes);
+        TraceReader reader(in);
+        TraceEvent event{};
+        for (const auto& want: expected) {
+            if (!reader.next(event) || event.op != want.op || event.arg != want.arg) {
+                return Report("trace round trip", false);
+            }
+        }
+        if (!Report("trace end", !reader.next(event))) {
+            return false;
+        }
+
+        if (bytes.size() > 4) {
+            std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+            TraceReader truncated_reader(truncated);
+            bool thrown = false;
+            try {
+                while (truncated_reader.next(event)) {
+                }
+            } catch (const std::runtime_error&) {
+                thrown = true;
+            }
+            if (!Report("truncated trace", thrown)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool TestRing(std::mt19937& mersenne_engine) {
+    for (size_t round = 0; round < kRounds; ++round) {
+        size_t capacity = mersenne_engine() % 12;
+        size_t allocations = 0;
+        RingDeque<std::string, CountingAllocator<std::string>> ring(
+            capacity, CountingAllocator<std::string>(&allocations));
+        size_t after_construction = allocations;
+        std::deque<std::string> expected;
+        for (size_t step = 0; step < 300; ++step) {
+            std::string value = std::to_string(step) + std::string(20, 'x');
+            switch (mersenne_engine() % 8) {
+                case 0:
+                case 1:
+                    ring.push_back(value);
+                    expected.push_back(value);
+                    if (expected.size() > capacity) {
+                        expected.pop_front();
+                    }
+                    break;
+                case 2:
+                    ring.push_front(value);
+                    expected.push_front(value);
+                    if (expected.size() > capacity) {
+                        expected.pop_back();
+                    }
+                    break;
+                case 3:
+                    if (!expected.empty()) {
+                        ring.push_back(ring[0]);
+                        expected.push_back(expected.front());
+                        if (expected.size() > capacity) {
+                            expected.pop_front();
+                        }
+                    }
+                    break;
+                case 4:
+                    if (!expected.empty()) {
+                        ring.emplace_front(ring[ring.size() - 1]);
+                        expected.push_front(expected.back());
+                        if (expected.size() > capacity) {
+                            expected.pop_back();
+                        }
+                    }
+                    break;
+                case 5:
+                    try {
+                        if (mersenne_engine() % 2 == 0) {
+                            ring.emplace_back(value, value.size() + 1);
+                        } else {
+                            ring.emplace_front(value, value.size() + 1);
+                        }
+                    } catch (const std::out_of_range&) {
+                    }
+                    break;
+                case 6:
+                    if (!expected.empty()) {
+                        ring.pop_back();
+                        expected.pop_back();
+                    }
+                    break;
+                default:
+                    if (!expected.empty()) {
+                        ring.pop_front();
+                        expected.pop_front();
+                    }
+                    break;
+            }
+            if (!Report("RingDeque", SameElements(ring, expected) &&
+                                         std::equal(ring.begin(), ring.end(), expected.begin(),
+                                                    expected.end()))) {
+                return false;
+            }
+        }
+        if (!Report("RingDeque allocations", allocations == after_construction)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TestDrain(std::mt19937& mersenne_engine) {
+    for (size_t round = 0; round < kRounds; ++round) {
+        Deque<std::string> d;
+        std::deque<std::string> expected;
+        std::vector<std::pair<Deque<std::string>::Snapshot, std::vector<std::string>>> snapshots;
+        for (size_t step = 0; step < 300; ++step) {
+            std::string value = std::to_string(step) + std::string(16, 'd');
+            size_t size = expected.size();
+            size_t count = 0;
+            switch (mersenne_engine() % 4) {
+                case 0:
+                    count = 0;
+                    break;
+                case 1:
+                    count = size;
+                    break;
+                default:
+                    count = mersenne_engine() % (size + 1);
+                    break;
+            }
+            switch (mersenne_engine() % 9) {
+                case 0:
+                case 1:
+                    d.push_back(value);
+                    expected.push_back(value);
+                    break;
+                case 2:
+                case 3:
+                    d.push_front(value);
+                    expected.push_front(value);
+                    break;
+                case 4:
+                    d.pop_front_n(count);
+                    expected.erase(expected.begin(), expected.begin() + static_cast<long>(count));
+                    break;
+                case 5:
+                    d.pop_back_n(count);
+                    expected.erase(expected.end() - static_cast<long>(count), expected.end());
+                    break;
+                case 6: {
+                    std::vector<std::string> drained;
+                    d.drain_front_into(std::back_inserter(drained), count);
+                    std::vector<std::string> want(expected.begin(),
+                                                  expected.begin() + static_cast<long>(count));
+                    expected.erase(expected.begin(), expected.begin() + static_cast<long>(count));
+                    if (!Report("drain_front_into", drained == want)) {
+                        return false;
+                    }
+                    break;
+                }
+                case 7: {
+                    std::vector<std::string> drained;
+                    d.drain_back_into(std::back_inserter(drained), count);
+                    std::vector<std::string> want(expected.rbegin(),
+                                                  expected.rbegin() + static_cast<long>(count));
+                    expected.erase(expected.end() - static_cast<long>(count), expected.end());
+                    if (!Report("drain_back_into", drained == want)) {
+                        return false;
+                    }
+                    break;
+                }
+                default:
+                    if (snapshots.size() < 3) {
+                        snapshots.emplace_back(d.snapshot(), std::vector<std::string>(
+                                                                 expected.begin(), expected.end()));
+                    } else {
+                        snapshots.erase(snapshots.begin());
+                    }
+                    break;
+            }
+            if (!Report("drain", SameElements(d, expected))) {
+                return false;
+            }
+            for (const auto& [snapshot, values]: snapshots) {
+                if (!Report("drain snapshot", SameElements(snapshot, values))) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool TestSorted(std::mt19937& mersenne_engine) {
+    for (size_t round = 0; round < kRounds; ++round) {
+        SortedDeque<int> d;
+        std::deque<int> expected;
+        int spread = 1 + static_cast<int>(mersenne_engine() % 50);
+        size_t steps = round % 10 == 0 ? 3000 : 300;
+        for (size_t step = 0; step < steps; ++step) {
+            switch (mersenne_engine() % 6) {
+                case 0:
+                case 1: {
+                    int value = (expected.empty() ? 0 : expected.back()) +
+                                static_cast<int>(mersenne_engine() % 3);
+                    d.push_back(value);
+                    expected.push_back(value);
+                    break;
+                }
+                case 2: {
+                    int value = (expected.empty() ? 0 : expected.front()) -
+                                static_cast<int>(mersenne_engine() % 3);
+                    d.push_front(value);
+                    expected.push_front(value);
+                    break;
+                }
+                case 3:
+                    if (!expected.empty()) {
+                        d.pop_back();
+                        expected.pop_back();
+                    }
+                    break;
+                case 4:
+                    if (!expected.empty()) {
+                        d.pop_front();
+                        expected.pop_front();
+                    }
+                    break;
+                default:
+                    break;
+            }
+            std::vector<int> sorted(expected.begin(), expected.end());
+            int low = sorted.empty() ? 0 : sorted.front() - spread;
+            int high = sorted.empty() ? 0 : sorted.back() + spread;
+            for (size_t query = 0; query < 4; ++query) {
+                int key = low + static_cast<int>(mersenne_engine() % static_cast<unsigned>(
+                                                     high - low + 1));
+                auto lower = static_cast<size_t>(
+                    std::lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin());
+                auto upper = static_cast<size_t>(
+                    std::upper_bound(sorted.begin(), sorted.end(), key) - sorted.begin());
+                if (!Report("SortedDeque lower_bound", d.lower_bound(key) == lower) ||
+                    !Report("SortedDeque upper_bound", d.upper_bound(key) == upper) ||
+                    !Report("SortedDeque equal_range",
+                            d.equal_range(key) == std::make_pair(lower, upper))) {
+                    return false;
+                }
+            }
+        }
+        if (!Report("SortedDeque", SameElements(d, expected))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TestReserve(std::mt19937& mersenne_engine) {
+    using Counted = Deque<int, CountingAllocator<int>>;
+    for (size_t round = 0; round < kRounds; ++round) {
+        size_t allocations = 0;
+        Counted d{CountingAllocator<int>(&allocations)};
+        std::deque<int> expected;
+        switch (round % 4) {
+            case 0:
+                break;
+            case 1:
+                d.push_back(1);
+                d.pop_back();
+                break;
+            case 2:
+                d.push_front(1);
+                d.pop_front();
+                break;
+            default:
+                for (int i = 0; i < 1000; ++i) {
+                    d.push_back(i);
+                    expected.push_back(i);
+                    if (expected.size() > 7) {
+                        d.pop_front();
+                        expected.pop_front();
+                    }
+                }
+                break;
+        }
+        size_t back = mersenne_engine() % 300;
+        size_t front = mersenne_engine() % 300;
+        d.reserve_back(back);
+        d.reserve_front(front);
+        if (!Report("reserve capacity", d.capacity_back() >= back && d.capacity_front() >= front) ||
+            !Report("reserve keeps elements", SameElements(d, expected))) {
+            return false;
+        }
+        size_t before = allocations;
+        size_t pushed_back = back == 0 ? 0 : mersenne_engine() % (back + 1);
+        size_t pushed_front = front == 0 ? 0 : mersenne_engine() % (front + 1);
+        for (size_t i = 0; i < pushed_back; ++i) {
+            d.push_back(static_cast<int>(i));
+            expected.push_back(static_cast<int>(i));
+        }
+        for (size_t i = 0; i < pushed_front; ++i) {
+            d.push_front(-static_cast<int>(i));
+            expected.push_front(-static_cast<int>(i));
+        }
+        if (!Report("reserved pushes allocate", allocations == before) ||
+            !Report("reserved pushes", SameElements(d, expected))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::mt19937 mersenne_engine{kSeed};
+
+    bool ok = TestSort(mersenne_engine);
+    ok = TestWindows(mersenne_engine) && ok;
+    ok = TestSoA(mersenne_engine) && ok;
+    ok = TestCompressed(mersenne_engine) && ok;
+    ok = TestAsync(mersenne_engine) && ok;
+    ok = TestHugePages(mersenne_engine) && ok;
+    ok = TestTiered(mersenne_engine) && ok;
+    ok = TestParallel(mersenne_engine) && ok;
+    ok = TestHandles(mersenne_engine) && ok;
+    ok = TestSnapshots(mersenne_engine) && ok;
+    ok = TestLinearize(mersenne_engine) && ok;
+    ok = TestTrace(mersenne_engine) && ok;
+    ok = TestRing(mersenne_engine) && ok;
+    ok = TestDrain(mersenne_engine) && ok;
+    ok = TestSorted(mersenne_engine) && ok;
+    ok = TestReserve(mersenne_engine) && ok;
+
+    std::cout << (ok ? "Random tests passed" : "Random tests failed") << std::endl;
+
+    return ok ? 0 : 1;
+}
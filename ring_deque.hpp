@@ -0,0 +1,374 @@
+#pragma once
+
+#include <iterator>
+#include <stdexcept>
+
+#include "deque.hpp"
+
+template <typename T, typename Allocator = std::allocator<T>>
+class RingDeque {
+ public:
+  RingDeque(size_t capacity, const Allocator& alloc = Allocator());
+
+  RingDeque(const RingDeque& other);
+
+  RingDeque(RingDeque&& other) noexcept;
+
+  ~RingDeque();
+
+  RingDeque& operator=(const RingDeque& other);
+
+  RingDeque& operator=(RingDeque&& other) noexcept;
+
+  [[nodiscard]] size_t size() const { return size_; }
+
+  [[nodiscard]] size_t capacity() const { return capacity_; }
+
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+
+  [[nodiscard]] bool full() const { return size_ == capacity_; }
+
+  T& operator[](size_t ind) { return *slot(ind); }
+
+  const T& operator[](size_t ind) const { return *slot(ind); }
+
+  T& at(size_t ind);
+
+  const T& at(size_t ind) const;
+
+  template <typename... Args>
+  void emplace_back(Args&&... args);
+
+  template <typename... Args>
+  void emplace_front(Args&&... args);
+
+  void push_back(const T& value) { emplace_back(value); }
+
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  void push_front(const T& value) { emplace_front(value); }
+
+  void push_front(T&& value) { emplace_front(std::move(value)); }
+
+  void pop_back();
+
+  void pop_front();
+
+  template <bool IsConst = false>
+  class BaseIterator;
+
+  using iterator = BaseIterator<false>;
+  using const_iterator = BaseIterator<true>;
+  using reverse_iterator = std::reverse_iterator<BaseIterator<false>>;
+  using const_reverse_iterator = std::reverse_iterator<BaseIterator<true>>;
+
+  iterator begin() { return iterator(this, 0); }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+
+  iterator end() { return iterator(this, size_); }
+
+  const_iterator end() const { return const_iterator(this, size_); }
+
+  const_iterator cbegin() const { return const_iterator(this, 0); }
+
+  const_iterator cend() const { return const_iterator(this, size_); }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+
+  const_reverse_iterator crbegin() const {
+    return const_reverse_iterator(cend());
+  }
+
+  const_reverse_iterator crend() const {
+    return const_reverse_iterator(cbegin());
+  }
+
+  [[nodiscard]] Allocator get_allocator() const { return alloc_; }
+
+  static const size_t kBucketSize = Deque<T, Allocator>::kBucketSize;
+
+ private:
+  using alloc = Allocator;
+  using bucket_alloc =
+      std::allocator_traits<Allocator>::template rebind_alloc<T*>;
+  using alloc_traits = std::allocator_traits<Allocator>;
+  using bucket_alloc_traits = std::allocator_traits<bucket_alloc>;
+
+  T* slot(size_t ind) const {
+    size_t pos = head_ + ind;
+    if (pos >= capacity_) {
+      pos -= capacity_;
+    }
+    return data_[pos / kBucketSize] + pos % kBucketSize;
+  }
+
+  void clear();
+
+  void swap(RingDeque& other) noexcept;
+
+  alloc alloc_;
+  bucket_alloc bucket_alloc_;
+
+  T** data_ = nullptr;
+  size_t bucket_cnt_ = 0;
+  size_t capacity_ = 0;
+  size_t head_ = 0;
+  size_t size_ = 0;
+};
+
+template <typename T, typename Allocator>
+template <bool IsConst>
+class RingDeque<T, Allocator>::BaseIterator {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::conditional_t<IsConst, const T, T>;
+  using pointer = value_type*;
+  using reference = value_type&;
+  using difference_type = std::ptrdiff_t;
+  using ring_ptr =
+      std::conditional_t<IsConst, const RingDeque*, RingDeque*>;
+
+  BaseIterator() = default;
+
+  BaseIterator(ring_ptr ring, size_t ind) : ring_(ring), ind_(ind) {}
+
+  operator BaseIterator<true>() const { return {ring_, ind_}; }
+
+  reference operator*() const { return *ring_->slot(ind_); }
+
+  pointer operator->() const { return ring_->slot(ind_); }
+
+  reference operator[](difference_type cnt) const { return *(*this + cnt); }
+
+  BaseIterator& operator+=(difference_type cnt) {
+    ind_ += cnt;
+    return *this;
+  }
+
+  BaseIterator& operator-=(difference_type cnt) {
+    ind_ -= cnt;
+    return *this;
+  }
+
+  BaseIterator operator+(difference_type cnt) const {
+    return {ring_, ind_ + cnt};
+  }
+
+  BaseIterator operator-(difference_type cnt) const {
+    return {ring_, ind_ - cnt};
+  }
+
+  difference_type operator-(const BaseIterator& rhs) const {
+    return static_cast<difference_type>(ind_) -
+           static_cast<difference_type>(rhs.ind_);
+  }
+
+  BaseIterator& operator++() {
+    ++ind_;
+    return *this;
+  }
+
+  BaseIterator operator++(int) {
+    auto tmp = *this;
+    ++ind_;
+    return tmp;
+  }
+
+  BaseIterator& operator--() {
+    --ind_;
+    return *this;
+  }
+
+  BaseIterator operator--(int) {
+    auto tmp = *this;
+    --ind_;
+    return tmp;
+  }
+
+  bool operator==(const BaseIterator& rhs) const {
+    return ring_ == rhs.ring_ && ind_ == rhs.ind_;
+  }
+
+  bool operator!=(const BaseIterator& rhs) const { return !(*this == rhs); }
+
+  bool operator<(const BaseIterator& rhs) const { return ind_ < rhs.ind_; }
+
+  bool operator>(const BaseIterator& rhs) const { return rhs < *this; }
+
+  bool operator<=(const BaseIterator& rhs) const { return !(rhs < *this); }
+
+  bool operator>=(const BaseIterator& rhs) const { return !(*this < rhs); }
+
+ private:
+  ring_ptr ring_ = nullptr;
+  size_t ind_ = 0;
+};
+
+template <typename T, typename Allocator>
+RingDeque<T, Allocator>::RingDeque(size_t capacity, const Allocator& alloc)
+    : alloc_(alloc), bucket_alloc_(alloc), capacity_(capacity) {
+  if (capacity == 0) {
+    return;
+  }
+  bucket_cnt_ = (capacity - 1) / kBucketSize + 1;
+  data_ = bucket_alloc_traits::allocate(bucket_alloc_, bucket_cnt_);
+  size_t ind = 0;
+  try {
+    for (; ind < bucket_cnt_; ++ind) {
+      data_[ind] = alloc_traits::allocate(alloc_, kBucketSize);
+    }
+  } catch (...) {
+    for (size_t i = 0; i < ind; ++i) {
+      alloc_traits::deallocate(alloc_, data_[i], kBucketSize);
+    }
+    bucket_alloc_traits::deallocate(bucket_alloc_, data_, bucket_cnt_);
+    throw;
+  }
+}
+
+template <typename T, typename Allocator>
+RingDeque<T, Allocator>::RingDeque(const RingDeque& other)
+    : RingDeque(other.capacity_,
+                alloc_traits::select_on_container_copy_construction(
+                    other.alloc_)) {
+  for (const auto& value : other) {
+    emplace_back(value);
+  }
+}
+
+template <typename T, typename Allocator>
+RingDeque<T, Allocator>::RingDeque(RingDeque&& other) noexcept
+    : alloc_(other.alloc_),
+      bucket_alloc_(other.bucket_alloc_),
+      data_(other.data_),
+      bucket_cnt_(other.bucket_cnt_),
+      capacity_(other.capacity_),
+      head_(other.head_),
+      size_(other.size_) {
+  other.data_ = nullptr;
+  other.bucket_cnt_ = 0;
+  other.capacity_ = 0;
+  other.head_ = 0;
+  other.size_ = 0;
+}
+
+template <typename T, typename Allocator>
+RingDeque<T, Allocator>::~RingDeque() {
+  clear();
+}
+
+template <typename T, typename Allocator>
+RingDeque<T, Allocator>& RingDeque<T, Allocator>::operator=(
+    const RingDeque& other) {
+  if (&other != this) {
+    RingDeque tmp(other);
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename T, typename Allocator>
+RingDeque<T, Allocator>& RingDeque<T, Allocator>::operator=(
+    RingDeque&& other) noexcept {
+  if (&other != this) {
+    RingDeque tmp(std::move(other));
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename T, typename Allocator>
+void RingDeque<T, Allocator>::clear() {
+  while (size_ > 0) {
+    pop_back();
+  }
+  for (size_t i = 0; i < bucket_cnt_; ++i) {
+    alloc_traits::deallocate(alloc_, data_[i], kBucketSize);
+  }
+  if (data_ != nullptr) {
+    bucket_alloc_traits::deallocate(bucket_alloc_, data_, bucket_cnt_);
+  }
+  data_ = nullptr;
+  bucket_cnt_ = 0;
+  head_ = 0;
+}
+
+template <typename T, typename Allocator>
+void RingDeque<T, Allocator>::swap(RingDeque& other) noexcept {
+  std::swap(alloc_, other.alloc_);
+  std::swap(bucket_alloc_, other.bucket_alloc_);
+  std::swap(data_, other.data_);
+  std::swap(bucket_cnt_, other.bucket_cnt_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(head_, other.head_);
+  std::swap(size_, other.size_);
+}
+
+template <typename T, typename Allocator>
+T& RingDeque<T, Allocator>::at(size_t ind) {
+  if (ind >= size_) {
+    throw std::out_of_range("Index out of range!");
+  }
+  return operator[](ind);
+}
+
+template <typename T, typename Allocator>
+const T& RingDeque<T, Allocator>::at(size_t ind) const {
+  if (ind >= size_) {
+    throw std::out_of_range("Index out of range!");
+  }
+  return operator[](ind);
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+void RingDeque<T, Allocator>::emplace_back(Args&&... args) {
+  if (capacity_ == 0) {
+    return;
+  }
+  if (size_ == capacity_) {
+    T value(std::forward<Args>(args)...);
+    pop_front();
+    emplace_back(std::move(value));
+    return;
+  }
+  alloc_traits::construct(alloc_, slot(size_), std::forward<Args>(args)...);
+  ++size_;
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+void RingDeque<T, Allocator>::emplace_front(Args&&... args) {
+  if (capacity_ == 0) {
+    return;
+  }
+  if (size_ == capacity_) {
+    T value(std::forward<Args>(args)...);
+    pop_back();
+    emplace_front(std::move(value));
+    return;
+  }
+  size_t new_head = head_ == 0 ? capacity_ - 1 : head_ - 1;
+  alloc_traits::construct(alloc_,
+                          data_[new_head / kBucketSize] +
+                              new_head % kBucketSize,
+                          std::forward<Args>(args)...);
+  head_ = new_head;
+  ++size_;
+}
+
+template <typename T, typename Allocator>
+void RingDeque<T, Allocator>::pop_back() {
+  alloc_traits::destroy(alloc_, slot(size_ - 1));
+  --size_;
+}
+
+template <typename T, typename Allocator>
+void RingDeque<T, Allocator>::pop_front() {
+  alloc_traits::destroy(alloc_, slot(0));
+  head_ = head_ + 1 == capacity_ ? 0 : head_ + 1;
+  --size_;
+}
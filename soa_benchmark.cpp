@@ -0,0 +1,88 @@
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include "deque.hpp"
+#include "soa_deque.hpp"
+
+struct Event {
+    long long timestamp;
+    long long user_id;
+    double price;
+    double quantity;
+    int kind;
+    int flags;
+};
+
+template <typename F>
+double MeasureMs(F&& func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+static constexpr size_t kTestSize = 4000000;
+static constexpr size_t kPasses = 5;
+
+int main() {
+    std::mt19937 mersenne_engine{42};
+    Deque<Event> rows;
+    SoADeque<long long, long long, double, double, int, int> columns;
+    for (size_t i = 0; i < kTestSize; ++i) {
+        Event event{static_cast<long long>(i), static_cast<long long>(mersenne_engine() % 1000),
+                    (mersenne_engine() % 10000) / 100.0, (mersenne_engine() % 100) / 10.0,
+                    static_cast<int>(mersenne_engine() % 4), 0};
+        rows.push_back(event);
+        columns.push_back({event.timestamp, event.user_id, event.price, event.quantity,
+                           event.kind, event.flags});
+    }
+
+    double sink = 0;
+    double struct_one = MeasureMs([&]() {
+        for (size_t pass = 0; pass < kPasses; ++pass) {
+            rows.for_each_segment([&sink](const Event* ptr, size_t len) {
+                for (size_t i = 0; i < len; ++i) {
+                    sink += ptr[i].price;
+                }
+            });
+        }
+    });
+    double soa_one = MeasureMs([&]() {
+        for (size_t pass = 0; pass < kPasses; ++pass) {
+            columns.for_each_segment<2>([&sink](const double* ptr, size_t len) {
+                for (size_t i = 0; i < len; ++i) {
+                    sink += ptr[i];
+                }
+            });
+        }
+    });
+    double struct_all = MeasureMs([&]() {
+        for (size_t pass = 0; pass < kPasses; ++pass) {
+            for (size_t i = 0; i < rows.size(); ++i) {
+                const Event& event = rows[static_cast<int>(i)];
+                sink += event.timestamp + event.user_id + event.price * event.quantity +
+                        event.kind + event.flags;
+            }
+        }
+    });
+    double soa_all = MeasureMs([&]() {
+        for (size_t pass = 0; pass < kPasses; ++pass) {
+            for (size_t i = 0; i < columns.size(); ++i) {
+                auto [timestamp, user_id, price, quantity, kind, flags] =
+                    std::as_const(columns)[static_cast<int>(i)];
+                sink += timestamp + user_id + price * quantity + kind + flags;
+            }
+        }
+    });
+
+    std::cout << "one-field scan: Deque<Event> " << struct_one << " ms, SoADeque "
+              << soa_one << " ms" << std::endl;
+    std::cout << "all-field scan: Deque<Event> " << struct_all << " ms, SoADeque "
+              << soa_all << " ms" << std::endl;
+    std::cout << "(checksum " << sink << ")" << std::endl;
+
+    return 0;
+}
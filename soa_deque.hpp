@@ -0,0 +1,362 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "deque.hpp"
+
+template <typename... Ts>
+class SoADeque {
+ public:
+  using value_type = std::tuple<Ts...>;
+  using reference = std::tuple<Ts&...>;
+  using const_reference = std::tuple<const Ts&...>;
+
+  template <size_t I>
+  using column_type = std::tuple_element_t<I, value_type>;
+
+  static const size_t kBucketSize = 512;
+
+  SoADeque() = default;
+
+  SoADeque(const SoADeque& other);
+
+  SoADeque(SoADeque&& other) noexcept;
+
+  ~SoADeque();
+
+  SoADeque& operator=(const SoADeque& other);
+
+  SoADeque& operator=(SoADeque&& other) noexcept;
+
+  [[nodiscard]] size_t size() const { return size_; }
+
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+
+  reference operator[](int ind) { return get_row(ind, Indices()); }
+
+  const_reference operator[](int ind) const {
+    return get_row(ind, Indices());
+  }
+
+  reference at(size_t ind);
+
+  const_reference at(size_t ind) const;
+
+  void push_back(const value_type& row);
+
+  void push_front(const value_type& row);
+
+  void pop_back();
+
+  void pop_front();
+
+  template <size_t I, typename F>
+  void for_each_segment(F&& func);
+
+  template <size_t I, typename F>
+  void for_each_segment(F&& func) const;
+
+ private:
+  using Indices = std::index_sequence_for<Ts...>;
+  using Bucket = std::tuple<Ts*...>;
+  using bucket_alloc = std::allocator<Bucket>;
+
+  template <size_t... Is>
+  reference get_row(int ind, std::index_sequence<Is...>) {
+    size_t slot = first_ + static_cast<size_t>(ind);
+    Bucket& bucket = map_[slot / kBucketSize];
+    return reference(std::get<Is>(bucket)[slot % kBucketSize]...);
+  }
+
+  template <size_t... Is>
+  const_reference get_row(int ind, std::index_sequence<Is...>) const {
+    size_t slot = first_ + static_cast<size_t>(ind);
+    const Bucket& bucket = map_[slot / kBucketSize];
+    return const_reference(std::get<Is>(bucket)[slot % kBucketSize]...);
+  }
+
+  template <size_t... Is>
+  void allocate_bucket(size_t bucket_num, std::index_sequence<Is...>);
+
+  template <size_t... Is>
+  void deallocate_bucket(size_t bucket_num, std::index_sequence<Is...>);
+
+  template <size_t... Is>
+  void construct_row(size_t slot, const value_type& row,
+                     std::index_sequence<Is...>);
+
+  template <size_t... Is>
+  void destroy_row(size_t slot, std::index_sequence<Is...>);
+
+  void make_room_back();
+
+  void make_room_front();
+
+  void grow_map();
+
+  void clear();
+
+  void swap(SoADeque& other) noexcept;
+
+  Bucket* map_ = nullptr;
+  size_t bucket_cnt_ = 0;
+  size_t first_ = 0;
+  size_t size_ = 0;
+};
+
+template <typename... Ts>
+SoADeque<Ts...>::SoADeque(const SoADeque& other) {
+  try {
+    for (size_t i = 0; i < other.size_; ++i) {
+      push_back(value_type(other[static_cast<int>(i)]));
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+
+template <typename... Ts>
+SoADeque<Ts...>::SoADeque(SoADeque&& other) noexcept
+    : map_(other.map_),
+      bucket_cnt_(other.bucket_cnt_),
+      first_(other.first_),
+      size_(other.size_) {
+  other.map_ = nullptr;
+  other.bucket_cnt_ = 0;
+  other.first_ = 0;
+  other.size_ = 0;
+}
+
+template <typename... Ts>
+SoADeque<Ts...>::~SoADeque() {
+  clear();
+}
+
+template <typename... Ts>
+SoADeque<Ts...>& SoADeque<Ts...>::operator=(const SoADeque& other) {
+  if (&other != this) {
+    SoADeque tmp(other);
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename... Ts>
+SoADeque<Ts...>& SoADeque<Ts...>::operator=(SoADeque&& other) noexcept {
+  if (&other != this) {
+    SoADeque tmp(std::move(other));
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename... Ts>
+typename SoADeque<Ts...>::reference SoADeque<Ts...>::at(size_t ind) {
+  if (ind >= size()) {
+    throw std::out_of_range("Index out of range!");
+  }
+  return operator[](static_cast<int>(ind));
+}
+
+template <typename... Ts>
+typename SoADeque<Ts...>::const_reference SoADeque<Ts...>::at(
+    size_t ind) const {
+  if (ind >= size()) {
+    throw std::out_of_range("Index out of range!");
+  }
+  return operator[](static_cast<int>(ind));
+}
+
+template <typename... Ts>
+template <size_t... Is>
+void SoADeque<Ts...>::allocate_bucket(size_t bucket_num,
+                                      std::index_sequence<Is...>) {
+  if (std::get<0>(map_[bucket_num]) != nullptr) {
+    return;
+  }
+  Bucket bucket{};
+  try {
+    ((std::get<Is>(bucket) =
+          std::allocator<column_type<Is>>().allocate(kBucketSize)),
+     ...);
+  } catch (...) {
+    ((std::get<Is>(bucket) != nullptr
+          ? std::allocator<column_type<Is>>().deallocate(std::get<Is>(bucket),
+                                                         kBucketSize)
+          : void()),
+     ...);
+    throw;
+  }
+  map_[bucket_num] = bucket;
+}
+
+template <typename... Ts>
+template <size_t... Is>
+void SoADeque<Ts...>::deallocate_bucket(size_t bucket_num,
+                                        std::index_sequence<Is...>) {
+  Bucket& bucket = map_[bucket_num];
+  if (std::get<0>(bucket) == nullptr) {
+    return;
+  }
+  (std::allocator<column_type<Is>>().deallocate(std::get<Is>(bucket),
+                                                kBucketSize),
+   ...);
+  bucket = Bucket{};
+}
+
+template <typename... Ts>
+template <size_t... Is>
+void SoADeque<Ts...>::construct_row(size_t slot, const value_type& row,
+                                    std::index_sequence<Is...>) {
+  Bucket& bucket = map_[slot / kBucketSize];
+  size_t pos = slot % kBucketSize;
+  size_t built = 0;
+  try {
+    ((std::construct_at(std::get<Is>(bucket) + pos, std::get<Is>(row)),
+      ++built),
+     ...);
+  } catch (...) {
+    ((Is < built ? std::destroy_at(std::get<Is>(bucket) + pos) : void()),
+     ...);
+    throw;
+  }
+}
+
+template <typename... Ts>
+template <size_t... Is>
+void SoADeque<Ts...>::destroy_row(size_t slot, std::index_sequence<Is...>) {
+  Bucket& bucket = map_[slot / kBucketSize];
+  size_t pos = slot % kBucketSize;
+  (std::destroy_at(std::get<Is>(bucket) + pos), ...);
+}
+
+template <typename... Ts>
+void SoADeque<Ts...>::make_room_back() {
+  size_t dead = first_ / kBucketSize;
+  if (dead != 0 && dead * 2 >= bucket_cnt_) {
+    std::rotate(map_, map_ + dead, map_ + bucket_cnt_);
+    first_ -= dead * kBucketSize;
+    return;
+  }
+  grow_map();
+}
+
+template <typename... Ts>
+void SoADeque<Ts...>::make_room_front() {
+  size_t used = (first_ + size_ + kBucketSize - 1) / kBucketSize;
+  size_t dead = bucket_cnt_ - used;
+  if (dead != 0 && dead * 2 >= bucket_cnt_) {
+    std::rotate(map_, map_ + used, map_ + bucket_cnt_);
+    first_ += dead * kBucketSize;
+    return;
+  }
+  grow_map();
+}
+
+template <typename... Ts>
+void SoADeque<Ts...>::grow_map() {
+  size_t new_cnt = bucket_cnt_ * 2 + 2;
+  size_t offset = (new_cnt - bucket_cnt_) / 2;
+  Bucket* new_map = bucket_alloc().allocate(new_cnt);
+  std::uninitialized_fill_n(new_map, new_cnt, Bucket{});
+  std::copy(map_, map_ + bucket_cnt_, new_map + offset);
+  if (map_ != nullptr) {
+    bucket_alloc().deallocate(map_, bucket_cnt_);
+  }
+  map_ = new_map;
+  bucket_cnt_ = new_cnt;
+  first_ += offset * kBucketSize;
+}
+
+template <typename... Ts>
+void SoADeque<Ts...>::clear() {
+  while (size_ > 0) {
+    pop_back();
+  }
+  for (size_t i = 0; i < bucket_cnt_; ++i) {
+    deallocate_bucket(i, Indices());
+  }
+  if (map_ != nullptr) {
+    bucket_alloc().deallocate(map_, bucket_cnt_);
+  }
+  map_ = nullptr;
+  bucket_cnt_ = 0;
+  first_ = 0;
+}
+
+template <typename... Ts>
+void SoADeque<Ts...>::swap(SoADeque& other) noexcept {
+  std::swap(map_, other.map_);
+  std::swap(bucket_cnt_, other.bucket_cnt_);
+  std::swap(first_, other.first_);
+  std::swap(size_, other.size_);
+}
+
+template <typename... Ts>
+void SoADeque<Ts...>::push_back(const value_type& row) {
+  if (first_ + size_ == bucket_cnt_ * kBucketSize) {
+    make_room_back();
+  }
+  size_t slot = first_ + size_;
+  allocate_bucket(slot / kBucketSize, Indices());
+  construct_row(slot, row, Indices());
+  ++size_;
+}
+
+template <typename... Ts>
+void SoADeque<Ts...>::push_front(const value_type& row) {
+  if (first_ == 0) {
+    make_room_front();
+  }
+  size_t slot = first_ - 1;
+  allocate_bucket(slot / kBucketSize, Indices());
+  construct_row(slot, row, Indices());
+  first_ = slot;
+  ++size_;
+}
+
+template <typename... Ts>
+void SoADeque<Ts...>::pop_back() {
+  destroy_row(first_ + size_ - 1, Indices());
+  --size_;
+}
+
+template <typename... Ts>
+void SoADeque<Ts...>::pop_front() {
+  destroy_row(first_, Indices());
+  ++first_;
+  --size_;
+}
+
+template <typename... Ts>
+template <size_t I, typename F>
+void SoADeque<Ts...>::for_each_segment(F&& func) {
+  size_t slot = first_;
+  size_t end = first_ + size_;
+  while (slot < end) {
+    size_t pos = slot % kBucketSize;
+    size_t len = std::min(kBucketSize - pos, end - slot);
+    func(std::get<I>(map_[slot / kBucketSize]) + pos, len);
+    slot += len;
+  }
+}
+
+template <typename... Ts>
+template <size_t I, typename F>
+void SoADeque<Ts...>::for_each_segment(F&& func) const {
+  size_t slot = first_;
+  size_t end = first_ + size_;
+  while (slot < end) {
+    size_t pos = slot % kBucketSize;
+    size_t len = std::min(kBucketSize - pos, end - slot);
+    func(static_cast<const column_type<I>*>(
+             std::get<I>(map_[slot / kBucketSize]) + pos),
+         len);
+    slot += len;
+  }
+}
@@ -0,0 +1,66 @@
+#include <random>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include "deque.hpp"
+
+template <typename F>
+double MeasureMs(F&& func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+void Report(const std::string& name, double ms) {
+    std::cout << name << ": " << ms << " ms" << std::endl;
+}
+
+static constexpr size_t kTestSize = 2000000;
+static constexpr size_t kMaxThreads = 8;
+
+int main() {
+    std::mt19937_64 mersenne_engine{42};
+    std::vector<long long> numbers(kTestSize);
+    for (auto& number: numbers) {
+        number = static_cast<long long>(mersenne_engine());
+    }
+
+    Deque<long long> source;
+    for (const auto& number: numbers) {
+        source.push_back(number);
+    }
+
+    {
+        Deque<long long> d = source;
+        Report("std::sort over Deque iterators",
+               MeasureMs([&d]() { std::sort(d.begin(), d.end()); }));
+    }
+    for (size_t threads = 1; threads <= kMaxThreads; threads *= 2) {
+        Deque<long long> d = source;
+        Report("Deque::sort, " + std::to_string(threads) + " threads",
+               MeasureMs([&d, threads]() {
+                   d.sort(std::less<long long>(), Deque<long long>::Parallel{threads});
+               }));
+    }
+    for (size_t threads = 1; threads <= kMaxThreads; threads *= 2) {
+        Deque<long long> d = source;
+        Report("Deque::stable_sort, " + std::to_string(threads) + " threads",
+               MeasureMs([&d, threads]() {
+                   d.stable_sort(std::less<long long>(), Deque<long long>::Parallel{threads});
+               }));
+    }
+    {
+        Deque<long long> d = source;
+        Report("Deque::radix_sort", MeasureMs([&d]() { d.radix_sort(); }));
+    }
+    {
+        std::vector<long long> v = numbers;
+        Report("std::sort over std::vector",
+               MeasureMs([&v]() { std::sort(v.begin(), v.end()); }));
+    }
+
+    return 0;
+}
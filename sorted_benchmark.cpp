@@ -0,0 +1,68 @@
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include "deque.hpp"
+#include "sorted_deque.hpp"
+
+static constexpr size_t kTestSizes[] = {100000, 1000000, 10000000};
+static constexpr size_t kQueries = 1000000;
+
+template <typename F>
+double MeasureMs(F&& func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+int main() {
+    std::mt19937 mersenne_engine{42};
+    for (size_t size: kTestSizes) {
+        SortedDeque<uint64_t> sorted;
+        std::vector<uint64_t> reference;
+        reference.reserve(size);
+        uint64_t key = 0;
+        for (size_t i = 0; i < size; ++i) {
+            key += mersenne_engine() % 1000;
+            sorted.push_back(key);
+            reference.push_back(key);
+        }
+        std::vector<uint64_t> queries(kQueries);
+        for (auto& query: queries) {
+            query = (static_cast<uint64_t>(mersenne_engine()) << 32 | mersenne_engine()) %
+                    (key + 1);
+        }
+
+        const Deque<uint64_t>& plain = sorted.deque();
+        size_t sink = 0;
+        double deque_ms = MeasureMs([&]() {
+            for (const auto& query: queries) {
+                sink += static_cast<size_t>(
+                    std::lower_bound(plain.begin(), plain.end(), query) - plain.begin());
+            }
+        });
+        double sorted_ms = MeasureMs([&]() {
+            for (const auto& query: queries) {
+                sink += sorted.lower_bound(query);
+            }
+        });
+        double vector_ms = MeasureMs([&]() {
+            for (const auto& query: queries) {
+                sink += static_cast<size_t>(
+                    std::lower_bound(reference.begin(), reference.end(), query) -
+                    reference.begin());
+            }
+        });
+
+        std::cout << "n=" << size << ": std::lower_bound on Deque "
+                  << deque_ms * 1e6 / kQueries << " ns, SortedDeque "
+                  << sorted_ms * 1e6 / kQueries << " ns, std::lower_bound on std::vector "
+                  << vector_ms * 1e6 / kQueries << " ns (checksum " << sink << ")" << std::endl;
+    }
+
+    return 0;
+}
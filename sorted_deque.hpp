@@ -0,0 +1,203 @@
+#pragma once
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "deque.hpp"
+
+template <typename T, typename Compare = std::less<T>,
+          typename Allocator = std::allocator<T>>
+class SortedDeque {
+ public:
+  static const size_t kFenceStride = 64;
+
+  SortedDeque(Compare comp = Compare(), const Allocator& alloc = Allocator())
+      : deque_(alloc), comp_(comp) {}
+
+  [[nodiscard]] size_t size() const { return deque_.size(); }
+
+  [[nodiscard]] bool empty() const { return deque_.empty(); }
+
+  const T& operator[](size_t ind) const {
+    return deque_[static_cast<int>(ind)];
+  }
+
+  const T& at(size_t ind) const { return deque_.at(ind); }
+
+  void push_back(const T& value);
+
+  void push_front(const T& value);
+
+  void pop_back();
+
+  void pop_front();
+
+  size_t lower_bound(const T& key) const;
+
+  size_t upper_bound(const T& key) const;
+
+  std::pair<size_t, size_t> equal_range(const T& key) const;
+
+  [[nodiscard]] const Deque<T, Allocator>& deque() const { return deque_; }
+
+ private:
+  static long long group_of(long long seq) {
+    long long stride = static_cast<long long>(kFenceStride);
+    return seq >= 0 ? seq / stride : -((-seq + stride - 1) / stride);
+  }
+
+  void reset_with(const T& value);
+
+  template <typename Less>
+  size_t search(Less less) const;
+
+  Deque<T, Allocator> deque_;
+  std::vector<T> fences_;
+  size_t head_ = 0;
+  long long base_ = 0;
+  long long first_group_ = 0;
+  Compare comp_;
+};
+
+template <typename T, typename Compare, typename Allocator>
+void SortedDeque<T, Compare, Allocator>::reset_with(const T& value) {
+  fences_.assign(1, value);
+  head_ = 0;
+  base_ = 0;
+  first_group_ = 0;
+}
+
+template <typename T, typename Compare, typename Allocator>
+void SortedDeque<T, Compare, Allocator>::push_back(const T& value) {
+  if (deque_.empty()) {
+    reset_with(value);
+  } else {
+    long long seq = base_ + static_cast<long long>(deque_.size());
+    if (group_of(seq) != group_of(seq - 1)) {
+      fences_.push_back(value);
+    }
+  }
+  try {
+    deque_.push_back(value);
+  } catch (...) {
+    long long seq = base_ + static_cast<long long>(deque_.size());
+    if (deque_.empty()) {
+      fences_.clear();
+    } else if (group_of(seq) != group_of(seq - 1)) {
+      fences_.pop_back();
+    }
+    throw;
+  }
+}
+
+template <typename T, typename Compare, typename Allocator>
+void SortedDeque<T, Compare, Allocator>::push_front(const T& value) {
+  if (deque_.empty()) {
+    reset_with(value);
+    try {
+      deque_.push_front(value);
+    } catch (...) {
+      fences_.clear();
+      throw;
+    }
+    return;
+  }
+  bool new_group = group_of(base_ - 1) != first_group_;
+  if (new_group && head_ == 0) {
+    size_t room = fences_.size();
+    fences_.insert(fences_.begin(), room, value);
+    head_ = room;
+  }
+  deque_.push_front(value);
+  --base_;
+  if (new_group) {
+    fences_[head_] = deque_[1];
+    --head_;
+    --first_group_;
+  }
+  fences_[head_] = value;
+}
+
+template <typename T, typename Compare, typename Allocator>
+void SortedDeque<T, Compare, Allocator>::pop_back() {
+  long long seq = base_ + static_cast<long long>(deque_.size()) - 1;
+  deque_.pop_back();
+  if (deque_.empty()) {
+    fences_.clear();
+    head_ = 0;
+  } else if (group_of(seq) != group_of(seq - 1)) {
+    fences_.pop_back();
+  }
+}
+
+template <typename T, typename Compare, typename Allocator>
+void SortedDeque<T, Compare, Allocator>::pop_front() {
+  deque_.pop_front();
+  ++base_;
+  if (deque_.empty()) {
+    fences_.clear();
+    head_ = 0;
+    return;
+  }
+  if (group_of(base_) != first_group_) {
+    ++head_;
+    ++first_group_;
+    if (head_ >= kFenceStride && head_ * 2 >= fences_.size()) {
+      fences_.erase(fences_.begin(), fences_.begin() + head_);
+      head_ = 0;
+    }
+  }
+}
+
+template <typename T, typename Compare, typename Allocator>
+template <typename Less>
+size_t SortedDeque<T, Compare, Allocator>::search(Less less) const {
+  if (deque_.empty()) {
+    return 0;
+  }
+  const T* fences = fences_.data() + head_ + 1;
+  const T* first = fences;
+  size_t len = fences_.size() - head_ - 1;
+  while (len > 1) {
+    size_t half = len / 2;
+    first = less(first[half]) ? first + half : first;
+    len -= half;
+  }
+  size_t group = static_cast<size_t>(first - fences);
+  if (len == 1 && less(*first)) {
+    ++group;
+  }
+
+  long long stride = static_cast<long long>(kFenceStride);
+  long long group_begin = (first_group_ + static_cast<long long>(group)) * stride;
+  size_t lo = group_begin > base_ ? static_cast<size_t>(group_begin - base_) : 0;
+  size_t hi = std::min(deque_.size(),
+                       static_cast<size_t>(group_begin + stride - base_));
+  len = hi - lo;
+  while (len > 1) {
+    size_t half = len / 2;
+    lo = less(deque_[static_cast<int>(lo + half)]) ? lo + half : lo;
+    len -= half;
+  }
+  if (len == 1 && less(deque_[static_cast<int>(lo)])) {
+    ++lo;
+  }
+  return lo;
+}
+
+template <typename T, typename Compare, typename Allocator>
+size_t SortedDeque<T, Compare, Allocator>::lower_bound(const T& key) const {
+  return search([this, &key](const T& value) { return comp_(value, key); });
+}
+
+template <typename T, typename Compare, typename Allocator>
+size_t SortedDeque<T, Compare, Allocator>::upper_bound(const T& key) const {
+  return search([this, &key](const T& value) { return !comp_(key, value); });
+}
+
+template <typename T, typename Compare, typename Allocator>
+std::pair<size_t, size_t> SortedDeque<T, Compare, Allocator>::equal_range(
+    const T& key) const {
+  return {lower_bound(key), upper_bound(key)};
+}
@@ -0,0 +1,55 @@
+#include <random>
+#include <cstdint>
+#include <chrono>
+#include <iostream>
+#include "deque.hpp"
+#include "tiered_deque.hpp"
+
+static constexpr size_t kOperations = 20000;
+
+template <typename Container, typename Insert>
+double MeasureNsPerOp(Container& container, unsigned insert_percent, uint64_t& sink,
+                      Insert&& insert) {
+    std::mt19937 mersenne_engine{42};
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < kOperations; ++i) {
+        unsigned roll = mersenne_engine() % 100;
+        if (roll < insert_percent) {
+            insert(container, mersenne_engine() % container.size(), i);
+        } else if (roll < 95) {
+            sink += container[mersenne_engine() % container.size()];
+        } else {
+            container.pop_front();
+        }
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() /
+           static_cast<double>(kOperations);
+}
+
+int main() {
+    for (size_t size: {size_t(2000), size_t(20000), size_t(200000)}) {
+        for (unsigned insert_percent: {0u, 10u, 50u, 90u}) {
+            uint64_t sink = 0;
+            Deque<uint64_t> d;
+            TieredDeque<uint64_t> tiered;
+            for (size_t i = 0; i < size; ++i) {
+                d.push_back(i);
+                tiered.push_back(i);
+            }
+            double deque_ns = MeasureNsPerOp(d, insert_percent, sink,
+                                             [](auto& container, size_t pos, uint64_t value) {
+                container.insert(container.begin() + static_cast<int>(pos), value);
+            });
+            double tiered_ns = MeasureNsPerOp(tiered, insert_percent, sink,
+                                              [](auto& container, size_t pos, uint64_t value) {
+                container.insert(pos, value);
+            });
+            std::cout << "size " << size << ", " << insert_percent << "% inserts: Deque "
+                      << deque_ns << " ns/op, TieredDeque " << tiered_ns << " ns/op (checksum "
+                      << sink << ")" << std::endl;
+        }
+    }
+
+    return 0;
+}
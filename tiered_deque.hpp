@@ -0,0 +1,473 @@
+#pragma once
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "deque.hpp"
+
+template <typename T, size_t BlockCapacity = 256,
+          typename Allocator = std::allocator<T>>
+class TieredDeque {
+ public:
+  TieredDeque() = default;
+
+  TieredDeque(const Allocator& alloc);
+
+  TieredDeque(const TieredDeque& other);
+
+  TieredDeque(TieredDeque&& other) noexcept;
+
+  TieredDeque& operator=(const TieredDeque& other) = delete;
+
+  TieredDeque& operator=(TieredDeque&& other) = delete;
+
+  ~TieredDeque();
+
+  [[nodiscard]] size_t size() const { return size_; }
+
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+
+  T& operator[](size_t ind);
+
+  const T& operator[](size_t ind) const;
+
+  T& at(size_t ind);
+
+  const T& at(size_t ind) const;
+
+  void push_back(const T& value);
+
+  void push_front(const T& value);
+
+  void pop_back();
+
+  void pop_front();
+
+  void insert(size_t pos, const T& value);
+
+  void erase(size_t pos);
+
+  template <typename F>
+  void for_each(F&& func) const;
+
+  [[nodiscard]] size_t block_count() const { return blocks_.size(); }
+
+  static const size_t kBlockCapacity = BlockCapacity;
+
+ private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  struct Block {
+    T* data;
+    size_t begin;
+    size_t count;
+  };
+
+  Block& block(size_t ind) { return blocks_[static_cast<int>(ind)]; }
+
+  const Block& block(size_t ind) const {
+    return blocks_[static_cast<int>(ind)];
+  }
+
+  std::pair<size_t, size_t> locate(size_t ind) const;
+
+  void rebuild_index() const;
+
+  void index_add(size_t block_ind, long long delta);
+
+  void index_push_back(size_t count);
+
+  Block make_block();
+
+  void free_block(Block& blk);
+
+  void split(size_t block_ind);
+
+  void maybe_merge(size_t block_ind);
+
+  void compact(Block& blk);
+
+  mutable Allocator alloc_;
+  Deque<Block> blocks_;
+  size_t size_ = 0;
+  mutable std::vector<size_t> index_;
+  mutable bool index_valid_ = true;
+};
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+TieredDeque<T, BlockCapacity, Allocator>::TieredDeque(const Allocator& alloc)
+    : alloc_(alloc) {}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+TieredDeque<T, BlockCapacity, Allocator>::TieredDeque(const TieredDeque& other)
+    : alloc_(alloc_traits::select_on_container_copy_construction(
+          other.alloc_)) {
+  try {
+    other.for_each([this](const T& value) { push_back(value); });
+  } catch (...) {
+    while (!empty()) {
+      pop_back();
+    }
+    throw;
+  }
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+TieredDeque<T, BlockCapacity, Allocator>::TieredDeque(
+    TieredDeque&& other) noexcept
+    : alloc_(other.alloc_),
+      blocks_(std::move(other.blocks_)),
+      size_(other.size_),
+      index_(std::move(other.index_)),
+      index_valid_(other.index_valid_) {
+  other.size_ = 0;
+  other.index_.clear();
+  other.index_valid_ = true;
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+TieredDeque<T, BlockCapacity, Allocator>::~TieredDeque() {
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    free_block(block(i));
+  }
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+typename TieredDeque<T, BlockCapacity, Allocator>::Block
+TieredDeque<T, BlockCapacity, Allocator>::make_block() {
+  return {alloc_traits::allocate(alloc_, BlockCapacity), 0, 0};
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+void TieredDeque<T, BlockCapacity, Allocator>::free_block(Block& blk) {
+  for (size_t j = blk.begin; j < blk.begin + blk.count; ++j) {
+    alloc_traits::destroy(alloc_, blk.data + j);
+  }
+  alloc_traits::deallocate(alloc_, blk.data, BlockCapacity);
+  blk.count = 0;
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+void TieredDeque<T, BlockCapacity, Allocator>::rebuild_index() const {
+  index_.assign(blocks_.size() + 1, 0);
+  for (size_t i = 1; i <= blocks_.size(); ++i) {
+    index_[i] += block(i - 1).count;
+    size_t parent = i + (i & (~i + 1));
+    if (parent <= blocks_.size()) {
+      index_[parent] += index_[i];
+    }
+  }
+  index_valid_ = true;
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+void TieredDeque<T, BlockCapacity, Allocator>::index_add(size_t block_ind,
+                                                         long long delta) {
+  if (!index_valid_) {
+    return;
+  }
+  for (size_t i = block_ind + 1; i < index_.size(); i += i & (~i + 1)) {
+    index_[i] += delta;
+  }
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+void TieredDeque<T, BlockCapacity, Allocator>::index_push_back(size_t count) {
+  if (!index_valid_) {
+    return;
+  }
+  size_t i = index_.size();
+  if (i == 0) {
+    index_.push_back(0);
+    i = 1;
+  }
+  size_t lowest = i & (~i + 1);
+  size_t value = count;
+  for (size_t j = i - 1; j > i - lowest; j -= j & (~j + 1)) {
+    value += index_[j];
+  }
+  index_.push_back(value);
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+std::pair<size_t, size_t> TieredDeque<T, BlockCapacity, Allocator>::locate(
+    size_t ind) const {
+  if (!index_valid_) {
+    rebuild_index();
+  }
+  size_t pos = 0;
+  size_t step = 1;
+  while (step * 2 < index_.size()) {
+    step *= 2;
+  }
+  for (; step > 0; step /= 2) {
+    if (pos + step < index_.size() && index_[pos + step] <= ind) {
+      pos += step;
+      ind -= index_[pos];
+    }
+  }
+  return {pos, ind};
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+T& TieredDeque<T, BlockCapacity, Allocator>::operator[](size_t ind) {
+  auto [block_ind, offset] = locate(ind);
+  Block& blk = block(block_ind);
+  return blk.data[blk.begin + offset];
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+const T& TieredDeque<T, BlockCapacity, Allocator>::operator[](
+    size_t ind) const {
+  auto [block_ind, offset] = locate(ind);
+  const Block& blk = block(block_ind);
+  return blk.data[blk.begin + offset];
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+T& TieredDeque<T, BlockCapacity, Allocator>::at(size_t ind) {
+  if (ind >= size_) {
+    throw std::out_of_range("Index out of range!");
+  }
+  return operator[](ind);
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+const T& TieredDeque<T, BlockCapacity, Allocator>::at(size_t ind) const {
+  if (ind >= size_) {
+    throw std::out_of_range("Index out of range!");
+  }
+  return operator[](ind);
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+void TieredDeque<T, BlockCapacity, Allocator>::push_back(const T& value) {
+  if (blocks_.empty() ||
+      block(blocks_.size() - 1).begin + block(blocks_.size() - 1).count ==
+          BlockCapacity) {
+    Block blk = make_block();
+    try {
+      alloc_traits::construct(alloc_, blk.data, value);
+    } catch (...) {
+      alloc_traits::deallocate(alloc_, blk.data, BlockCapacity);
+      throw;
+    }
+    blk.count = 1;
+    try {
+      blocks_.push_back(blk);
+    } catch (...) {
+      free_block(blk);
+      throw;
+    }
+    index_push_back(1);
+  } else {
+    Block& blk = block(blocks_.size() - 1);
+    alloc_traits::construct(alloc_, blk.data + blk.begin + blk.count, value);
+    ++blk.count;
+    index_add(blocks_.size() - 1, 1);
+  }
+  ++size_;
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+void TieredDeque<T, BlockCapacity, Allocator>::push_front(const T& value) {
+  if (blocks_.empty() || block(0).begin == 0) {
+    Block blk = make_block();
+    blk.begin = BlockCapacity - 1;
+    try {
+      alloc_traits::construct(alloc_, blk.data + blk.begin, value);
+    } catch (...) {
+      alloc_traits::deallocate(alloc_, blk.data, BlockCapacity);
+      throw;
+    }
+    blk.count = 1;
+    try {
+      blocks_.push_front(blk);
+    } catch (...) {
+      free_block(blk);
+      throw;
+    }
+    index_valid_ = false;
+  } else {
+    Block& blk = block(0);
+    alloc_traits::construct(alloc_, blk.data + blk.begin - 1, value);
+    --blk.begin;
+    ++blk.count;
+    index_add(0, 1);
+  }
+  ++size_;
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+void TieredDeque<T, BlockCapacity, Allocator>::pop_back() {
+  size_t last = blocks_.size() - 1;
+  Block& blk = block(last);
+  --blk.count;
+  alloc_traits::destroy(alloc_, blk.data + blk.begin + blk.count);
+  --size_;
+  if (blk.count == 0) {
+    free_block(blk);
+    blocks_.pop_back();
+    if (index_valid_) {
+      index_.pop_back();
+    }
+  } else {
+    index_add(last, -1);
+  }
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+void TieredDeque<T, BlockCapacity, Allocator>::pop_front() {
+  Block& blk = block(0);
+  alloc_traits::destroy(alloc_, blk.data + blk.begin);
+  ++blk.begin;
+  --blk.count;
+  --size_;
+  if (blk.count == 0) {
+    free_block(blk);
+    blocks_.pop_front();
+    index_valid_ = false;
+  } else {
+    index_add(0, -1);
+  }
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+void TieredDeque<T, BlockCapacity, Allocator>::compact(Block& blk) {
+  if (blk.begin == 0) {
+    return;
+  }
+  for (size_t j = 0; j < blk.count; ++j) {
+    T* from = blk.data + blk.begin + j;
+    alloc_traits::construct(alloc_, blk.data + j, std::move(*from));
+    alloc_traits::destroy(alloc_, from);
+  }
+  blk.begin = 0;
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+void TieredDeque<T, BlockCapacity, Allocator>::split(size_t block_ind) {
+  Block fresh = make_block();
+  try {
+    blocks_.insert(blocks_.begin() + static_cast<int>(block_ind) + 1, fresh);
+  } catch (...) {
+    alloc_traits::deallocate(alloc_, fresh.data, BlockCapacity);
+    throw;
+  }
+  Block& blk = block(block_ind);
+  Block& next = block(block_ind + 1);
+  size_t keep = blk.count / 2;
+  for (size_t j = keep; j < blk.count; ++j) {
+    T* from = blk.data + blk.begin + j;
+    alloc_traits::construct(alloc_, next.data + next.count, std::move(*from));
+    alloc_traits::destroy(alloc_, from);
+    ++next.count;
+  }
+  blk.count = keep;
+  index_valid_ = false;
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+void TieredDeque<T, BlockCapacity, Allocator>::maybe_merge(size_t block_ind) {
+  if (block(block_ind).count == 0) {
+    free_block(block(block_ind));
+    blocks_.erase(blocks_.begin() + static_cast<int>(block_ind));
+    index_valid_ = false;
+    return;
+  }
+  if (block(block_ind).count >= BlockCapacity / 4 ||
+      block_ind + 1 >= blocks_.size()) {
+    return;
+  }
+  Block& blk = block(block_ind);
+  Block& next = block(block_ind + 1);
+  if (blk.count + next.count > BlockCapacity / 2) {
+    return;
+  }
+  compact(blk);
+  for (size_t j = 0; j < next.count; ++j) {
+    T* from = next.data + next.begin + j;
+    alloc_traits::construct(alloc_, blk.data + blk.count, std::move(*from));
+    alloc_traits::destroy(alloc_, from);
+    ++blk.count;
+  }
+  next.count = 0;
+  free_block(next);
+  blocks_.erase(blocks_.begin() + static_cast<int>(block_ind) + 1);
+  index_valid_ = false;
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+void TieredDeque<T, BlockCapacity, Allocator>::insert(size_t pos,
+                                                      const T& value) {
+  if (pos == size_) {
+    push_back(value);
+    return;
+  }
+  if (pos == 0) {
+    push_front(value);
+    return;
+  }
+  auto [block_ind, offset] = locate(pos);
+  if (block(block_ind).count == BlockCapacity) {
+    split(block_ind);
+    std::tie(block_ind, offset) = locate(pos);
+  }
+  Block& blk = block(block_ind);
+  T copy(value);
+  bool shift_left =
+      blk.begin > 0 &&
+      (offset < blk.count / 2 || blk.begin + blk.count == BlockCapacity);
+  if (shift_left) {
+    T* first = blk.data + blk.begin;
+    if (offset == 0) {
+      alloc_traits::construct(alloc_, first - 1, std::move(copy));
+    } else {
+      alloc_traits::construct(alloc_, first - 1, std::move(*first));
+      std::move(first + 1, first + offset, first);
+      first[offset - 1] = std::move(copy);
+    }
+    --blk.begin;
+  } else {
+    T* last = blk.data + blk.begin + blk.count;
+    alloc_traits::construct(alloc_, last, std::move(*(last - 1)));
+    std::move_backward(blk.data + blk.begin + offset, last - 1, last);
+    blk.data[blk.begin + offset] = std::move(copy);
+  }
+  ++blk.count;
+  ++size_;
+  index_add(block_ind, 1);
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+void TieredDeque<T, BlockCapacity, Allocator>::erase(size_t pos) {
+  auto [block_ind, offset] = locate(pos);
+  Block& blk = block(block_ind);
+  T* first = blk.data + blk.begin;
+  if (offset < blk.count / 2) {
+    std::move_backward(first, first + offset, first + offset + 1);
+    alloc_traits::destroy(alloc_, first);
+    ++blk.begin;
+  } else {
+    std::move(first + offset + 1, first + blk.count, first + offset);
+    alloc_traits::destroy(alloc_, first + blk.count - 1);
+  }
+  --blk.count;
+  --size_;
+  index_add(block_ind, -1);
+  maybe_merge(block_ind);
+}
+
+template <typename T, size_t BlockCapacity, typename Allocator>
+template <typename F>
+void TieredDeque<T, BlockCapacity, Allocator>::for_each(F&& func) const {
+  blocks_.for_each_segment([&func](const Block* blocks, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+      const T* first = blocks[i].data + blocks[i].begin;
+      for (size_t j = 0; j < blocks[i].count; ++j) {
+        func(first[j]);
+      }
+    }
+  });
+}
@@ -0,0 +1,199 @@
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "deque.hpp"
+#include "deque_trace.hpp"
+#include "huge_page_allocator.hpp"
+
+static size_t allocation_count = 0;
+
+template <typename Base>
+class CountingAllocator : public Base {
+ public:
+  using value_type = typename Base::value_type;
+
+  template <typename U>
+  struct rebind {
+    using other = CountingAllocator<
+        typename std::allocator_traits<Base>::template rebind_alloc<U>>;
+  };
+
+  CountingAllocator() = default;
+
+  template <typename Other>
+  CountingAllocator(const CountingAllocator<Other>& other)
+      : Base(static_cast<const Other&>(other)) {}
+
+  value_type* allocate(size_t n) {
+    ++allocation_count;
+    return Base::allocate(n);
+  }
+};
+
+static constexpr size_t kSampleOps = 1000000;
+static constexpr unsigned kSampleSeed = 20240607;
+
+void Check(bool valid, size_t event_ind) {
+  if (!valid) {
+    throw std::runtime_error("Invalid deque trace at operation " +
+                             std::to_string(event_ind) + "!");
+  }
+}
+
+void WriteSample(std::ostream& out) {
+  std::mt19937 mersenne_engine(kSampleSeed);
+  TraceWriter writer(out);
+  TracedDeque<uint64_t> deque(writer);
+  for (size_t i = 0; i < kSampleOps; ++i) {
+    size_t size = deque.size();
+    switch (mersenne_engine() % 16) {
+      case 0:
+      case 1:
+        deque.push_back(i);
+        break;
+      case 2:
+        deque.push_front(i);
+        break;
+      case 3:
+      case 4:
+        if (size != 0) {
+          deque.pop_back();
+        }
+        break;
+      case 5:
+        if (size != 0) {
+          deque.pop_front();
+        }
+        break;
+      case 6:
+        if (size != 0 && size < 256) {
+          deque.insert(deque.begin() +
+                           static_cast<int>(mersenne_engine() % size),
+                       i);
+        }
+        break;
+      case 7:
+        if (size != 0 && size < 256) {
+          deque.erase(deque.begin() +
+                      static_cast<int>(mersenne_engine() % size));
+        }
+        break;
+      default:
+        if (size != 0) {
+          static_cast<void>(deque[static_cast<int>(mersenne_engine() % size)]);
+        }
+        break;
+    }
+  }
+}
+
+template <typename Container>
+void Replay(const std::string& name, const std::vector<TraceEvent>& events) {
+  allocation_count = 0;
+  uint64_t sink = 0;
+  uint64_t next_value = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  {
+    Container container;
+    for (size_t i = 0; i < events.size(); ++i) {
+      const auto& event = events[i];
+      switch (event.op) {
+        case TraceOp::kPushBack:
+          container.push_back(next_value++);
+          break;
+        case TraceOp::kPushFront:
+          container.push_front(next_value++);
+          break;
+        case TraceOp::kPopBack:
+          Check(!container.empty(), i);
+          container.pop_back();
+          break;
+        case TraceOp::kPopFront:
+          Check(!container.empty(), i);
+          container.pop_front();
+          break;
+        case TraceOp::kInsert:
+          Check(event.arg <= container.size(), i);
+          container.insert(container.begin() + static_cast<int>(event.arg),
+                           next_value++);
+          break;
+        case TraceOp::kErase:
+          Check(event.arg < container.size(), i);
+          container.erase(container.begin() + static_cast<int>(event.arg));
+          break;
+        case TraceOp::kIndex:
+          Check(event.arg < container.size(), i);
+          sink += container[static_cast<int>(event.arg)];
+          break;
+        case TraceOp::kSize:
+          Check(event.arg == container.size(), i);
+          sink += container.size();
+          break;
+        default:
+          throw std::runtime_error("Invalid deque trace!");
+      }
+    }
+  }
+  auto stop = std::chrono::high_resolution_clock::now();
+
+  double ns_per_op =
+      std::chrono::duration<double, std::nano>(stop - start).count() /
+      static_cast<double>(events.empty() ? 1 : events.size());
+  std::cout << name << ": " << ns_per_op << " ns/op, " << allocation_count
+            << " allocations (checksum " << sink << ")" << std::endl;
+}
+
+int main(int argc, char** argv) {
+  if (argc == 3 && std::string(argv[1]) == "--sample") {
+    std::ofstream out(argv[2], std::ios::binary);
+    if (!out) {
+      std::cerr << "Cannot open " << argv[2] << std::endl;
+      return 2;
+    }
+    WriteSample(out);
+    return 0;
+  }
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " [--sample] <trace file>"
+              << std::endl;
+    return 2;
+  }
+  std::ifstream in(argv[1], std::ios::binary);
+  if (!in) {
+    std::cerr << "Cannot open " << argv[1] << std::endl;
+    return 2;
+  }
+
+  std::vector<TraceEvent> events;
+  try {
+    TraceReader reader(in);
+    TraceEvent event{};
+    while (reader.next(event)) {
+      events.push_back(event);
+    }
+  } catch (const std::exception& error) {
+    std::cerr << error.what() << std::endl;
+    return 2;
+  }
+  std::cout << events.size() << " operations" << std::endl;
+
+  try {
+    Replay<Deque<uint64_t, CountingAllocator<std::allocator<uint64_t>>>>(
+        "Deque", events);
+    Replay<Deque<uint64_t, CountingAllocator<HugePageAllocator<uint64_t>>>>(
+        "Deque + HugePageAllocator", events);
+    Replay<std::deque<uint64_t, CountingAllocator<std::allocator<uint64_t>>>>(
+        "std::deque", events);
+  } catch (const std::exception& error) {
+    std::cerr << error.what() << std::endl;
+    return 2;
+  }
+
+  return 0;
+}
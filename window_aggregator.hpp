@@ -0,0 +1,127 @@
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <utility>
+
+#include "deque.hpp"
+
+template <typename T, typename Op>
+class WindowAggregator {
+ public:
+  WindowAggregator(size_t window = 0, Op op = Op());
+
+  [[nodiscard]] size_t size() const { return values_.size(); }
+
+  [[nodiscard]] bool empty() const { return values_.empty(); }
+
+  void push(const T& value);
+
+  void evict();
+
+  [[nodiscard]] T query() const;
+
+ private:
+  void flip();
+
+  Op op_;
+  size_t window_ = 0;
+  Deque<T> values_;
+  size_t front_len_ = 0;
+  std::optional<T> back_agg_;
+};
+
+template <typename T, typename Compare = std::less<T>>
+class MonotonicWindow {
+ public:
+  MonotonicWindow(size_t window = 0, Compare comp = Compare());
+
+  [[nodiscard]] size_t size() const { return pushed_ - evicted_; }
+
+  [[nodiscard]] bool empty() const { return pushed_ == evicted_; }
+
+  void push(const T& value);
+
+  void evict();
+
+  [[nodiscard]] const T& query() const { return candidates_[0].first; }
+
+ private:
+  Compare comp_;
+  size_t window_ = 0;
+  size_t pushed_ = 0;
+  size_t evicted_ = 0;
+  Deque<std::pair<T, size_t>> candidates_;
+};
+
+template <typename T, typename Op>
+WindowAggregator<T, Op>::WindowAggregator(size_t window, Op op)
+    : op_(std::move(op)), window_(window) {}
+
+template <typename T, typename Op>
+void WindowAggregator<T, Op>::push(const T& value) {
+  if (window_ != 0 && values_.size() == window_) {
+    evict();
+  }
+  values_.push_back(value);
+  if (back_agg_) {
+    back_agg_ = op_(*back_agg_, value);
+  } else {
+    back_agg_ = value;
+  }
+}
+
+template <typename T, typename Op>
+void WindowAggregator<T, Op>::evict() {
+  if (front_len_ == 0) {
+    flip();
+  }
+  values_.pop_front();
+  --front_len_;
+}
+
+template <typename T, typename Op>
+T WindowAggregator<T, Op>::query() const {
+  if (front_len_ == 0) {
+    return *back_agg_;
+  }
+  if (!back_agg_) {
+    return values_[0];
+  }
+  return op_(values_[0], *back_agg_);
+}
+
+template <typename T, typename Op>
+void WindowAggregator<T, Op>::flip() {
+  int last = static_cast<int>(values_.size()) - 1;
+  for (int i = last - 1; i >= 0; --i) {
+    values_[i] = op_(values_[i], values_[i + 1]);
+  }
+  front_len_ = values_.size();
+  back_agg_.reset();
+}
+
+template <typename T, typename Compare>
+MonotonicWindow<T, Compare>::MonotonicWindow(size_t window, Compare comp)
+    : comp_(std::move(comp)), window_(window) {}
+
+template <typename T, typename Compare>
+void MonotonicWindow<T, Compare>::push(const T& value) {
+  if (window_ != 0 && size() == window_) {
+    evict();
+  }
+  while (!candidates_.empty() &&
+         !comp_(candidates_[static_cast<int>(candidates_.size()) - 1].first,
+                value)) {
+    candidates_.pop_back();
+  }
+  candidates_.emplace_back(value, pushed_++);
+}
+
+template <typename T, typename Compare>
+void MonotonicWindow<T, Compare>::evict() {
+  if (candidates_[0].second == evicted_) {
+    candidates_.pop_front();
+  }
+  ++evicted_;
+}
@@ -0,0 +1,71 @@
+#include <random>
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <numeric>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <iostream>
+#include "window_aggregator.hpp"
+
+template <typename F>
+double MeasureNsPerPush(size_t pushes, F&& func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() /
+           static_cast<double>(pushes);
+}
+
+static constexpr size_t kTestSize = 20000000;
+static constexpr size_t kNaiveLimit = 1024;
+static constexpr size_t kNaivePushes = 2000000;
+
+int main() {
+    std::mt19937 mersenne_engine{42};
+    std::uniform_int_distribution<long long> dist{1, 1000000};
+    std::vector<long long> values(kTestSize);
+    std::generate(values.begin(), values.end(), [&]() { return dist(mersenne_engine); });
+
+    for (size_t window: {size_t(1024), size_t(65536), size_t(1) << 20, size_t(10000000)}) {
+        unsigned long long sink = 0;
+        std::cout << "window " << window << ":" << std::endl;
+
+        double sum_ns = MeasureNsPerPush(kTestSize, [&]() {
+            WindowAggregator<long long, std::plus<long long>> aggregator(window);
+            for (const auto& value: values) {
+                aggregator.push(value);
+                sink += static_cast<unsigned long long>(aggregator.query());
+            }
+        });
+        std::cout << "  WindowAggregator sum: " << sum_ns << " ns/push" << std::endl;
+
+        double min_ns = MeasureNsPerPush(kTestSize, [&]() {
+            MonotonicWindow<long long> minimum(window);
+            for (const auto& value: values) {
+                minimum.push(value);
+                sink += static_cast<unsigned long long>(minimum.query());
+            }
+        });
+        std::cout << "  MonotonicWindow min: " << min_ns << " ns/push" << std::endl;
+
+        if (window <= kNaiveLimit) {
+            double naive_ns = MeasureNsPerPush(kNaivePushes, [&]() {
+                std::deque<long long> last;
+                for (size_t i = 0; i < kNaivePushes; ++i) {
+                    long long value = values[i];
+                    if (last.size() == window) {
+                        last.pop_front();
+                    }
+                    last.push_back(value);
+                    sink += static_cast<unsigned long long>(*std::min_element(last.begin(), last.end()));
+                }
+            });
+            std::cout << "  std::deque rescan min: " << naive_ns << " ns/push" << std::endl;
+        }
+        std::cout << "  (checksum " << sink << ")" << std::endl;
+    }
+
+    return 0;
+}